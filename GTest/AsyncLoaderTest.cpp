@@ -0,0 +1,146 @@
+//
+//  AsyncLoaderTest.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <stdexcept>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "WavefrontFileReader.h"
+#include "WavefrontObject.hpp"
+#include "AsyncLoader.h"
+
+using namespace std;
+using namespace WavefrontFileReader;
+
+/// Write a grid of size x size quads, a file of several steps
+static void writeGrid(const string& fileName, int size)
+{
+    ofstream file(fileName, ios::binary | ios::trunc);
+    for( int y = 0; y <= size; ++y )
+    {
+        for( int x = 0; x <= size; ++x )
+        {
+            file << "v " << x << " " << y << " " << ((x * y) % 7) * 0.125 << "\n";
+        }
+    }
+    for( int y = 0; y < size; ++y )
+    {
+        for( int x = 0; x < size; ++x )
+        {
+            const int a = y * (size + 1) + x + 1;
+            file << "f " << a << " " << a + 1 << " " << a + size + 2 << " " << a + size + 1 << "\n";
+        }
+    }
+}
+
+// the callback runs on another thread, the call doesn't wait for it
+TEST(AsyncLoader, ReturnsImmediately)
+{
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::promise<std::shared_ptr<IObject>> loaded;
+
+    const auto start = chrono::steady_clock::now();
+    WavefrontFileReader::loadFile("cube.obj", [&](std::shared_ptr<IObject> object) {
+        // a synchronous load would block the caller here
+        released.wait_for(chrono::seconds(5));
+        loaded.set_value(object);
+    });
+    const chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    EXPECT_LT(elapsed.count(), 1.0);
+
+    release.set_value();
+    auto object = loaded.get_future().get();
+    ASSERT_TRUE(object != nullptr);
+    ASSERT_EQ(WavefrontFileReader::loadFile("cube.obj")->vertices.size(), object->vertices.size());
+}
+
+TEST(AsyncLoader, Result)
+{
+    writeGrid("async_grid.obj", 300);
+    const size_t fileSize = ifstream("async_grid.obj", ios::binary | ios::ate).tellg();
+    ASSERT_GT(fileSize, 2 * kProgressStep);
+
+    LoadHandle handle = loadFileAsync("async_grid.obj");
+    ASSERT_TRUE(handle.valid());
+
+    // the progress only grows until the whole file is parsed
+    float progress = 0.0f;
+    while( !handle.ready() )
+    {
+        ASSERT_GE(handle.progress(), progress);
+        progress = handle.progress();
+        ASSERT_LE(progress, 1.0f);
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+
+    auto object = handle.get();
+    ASSERT_EQ(fileSize, handle.bytesTotal());
+    ASSERT_EQ(fileSize, handle.bytesLoaded());
+    ASSERT_EQ(1.0f, handle.progress());
+    ASSERT_FALSE(handle.cancelled());
+
+    auto expected = WavefrontFileReader::loadFile("async_grid.obj");
+    ASSERT_TRUE(expected->vertices == object->vertices);
+    ASSERT_EQ(expected->meshes.size(), object->meshes.size());
+    ASSERT_EQ(expected->meshes[0].faces.indices(), object->meshes[0].faces.indices());
+    ASSERT_TRUE(expected->bounds.low == object->bounds.low);
+
+    remove("async_grid.obj");
+}
+
+TEST(AsyncLoader, Cancel)
+{
+    writeGrid("async_cancel.obj", 500);
+
+    LoadHandle handle = loadFileAsync("async_cancel.obj");
+    handle.cancel();
+    ASSERT_TRUE(handle.cancelled());
+    ASSERT_THROW(handle.get(), LoadCancelled);
+    // stopped before the file was opened or before its end
+    ASSERT_TRUE((handle.bytesTotal() == 0) || (handle.bytesLoaded() < handle.bytesTotal()));
+
+    // the callback is told the load didn't finish
+    std::promise<std::shared_ptr<IObject>> loaded;
+    LoadHandle other = loadFileAsync("async_cancel.obj", [&loaded](std::shared_ptr<IObject> object) {
+        loaded.set_value(object);
+    });
+    other.cancel();
+    ASSERT_TRUE(loaded.get_future().get() == nullptr);
+
+    remove("async_cancel.obj");
+}
+
+// the vertex buffer is built on the worker too
+TEST(AsyncLoader, VertexBuffer)
+{
+    VertexBufferOptions options;
+    options.shortIndices = true;
+    options.vertexFormat = VertexLayout::Normalized16;
+
+    auto object = loadFileAsync("ducky.obj", options).get();
+    const VertexBuffer& buffer = static_cast<const Object&>(*object).m_vertexBuffer;
+    ASSERT_FALSE(buffer.empty());
+
+    auto expected = WavefrontFileReader::loadFile("ducky.obj");
+    static_cast<const Object&>(*expected).generateVertexBuffers(options);
+    ASSERT_EQ(expected->vertexBuffer().packedVbo, buffer.packedVbo);
+    ASSERT_EQ(expected->vertexBuffer().ibo16, buffer.ibo16);
+}
+
+TEST(AsyncLoader, MissingFile)
+{
+    LoadHandle handle = loadFileAsync("missing.obj");
+    ASSERT_THROW(handle.get(), std::runtime_error);
+    ASSERT_FALSE(handle.cancelled());
+}
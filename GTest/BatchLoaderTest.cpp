@@ -0,0 +1,147 @@
+//
+//  BatchLoaderTest.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "WavefrontFileReader.h"
+#include "WavefrontObject.hpp"
+#include "BatchLoader.h"
+
+using namespace std;
+using namespace WavefrontFileReader;
+
+static size_t fileSize(const string& fileName)
+{
+    return size_t(ifstream(fileName, ios::binary | ios::ate).tellg());
+}
+
+// results in the order of the paths, the missing file with its error
+TEST(BatchLoader, Ordered)
+{
+    const vector<string> paths = { "ducky.obj", "cube.obj", "missing.obj", "cub2.obj", "ducky.obj" };
+
+    BatchStatistics statistics;
+    const auto results = loadFiles(paths, BatchOptions(), &statistics);
+    ASSERT_EQ(paths.size(), results.size());
+
+    size_t bytes = 0;
+    for( size_t i = 0; i < paths.size(); ++i )
+    {
+        const BatchResult& result = results[i];
+        ASSERT_EQ(i, result.index);
+        ASSERT_EQ(paths[i], result.path);
+
+        if( paths[i] == "missing.obj" )
+        {
+            ASSERT_TRUE(result.object == nullptr);
+            ASSERT_FALSE(result.error.empty());
+            continue;
+        }
+
+        ASSERT_TRUE(result.object != nullptr);
+        ASSERT_TRUE(result.error.empty());
+        ASSERT_EQ(fileSize(paths[i]), result.bytes);
+        bytes += result.bytes;
+
+        auto expected = WavefrontFileReader::loadFile(paths[i]);
+        ASSERT_TRUE(expected->vertices == result.object->vertices);
+        ASSERT_EQ(expected->meshes.size(), result.object->meshes.size());
+
+        // the vertex buffer was built by the batch
+        const VertexBuffer& buffer = static_cast<const Object&>(*result.object).m_vertexBuffer;
+        ASSERT_FALSE(buffer.empty());
+        ASSERT_TRUE(expected->vertexBuffer().ibo == buffer.ibo);
+    }
+
+    ASSERT_EQ(4, statistics.files);
+    ASSERT_EQ(1, statistics.failed);
+    ASSERT_EQ(bytes, statistics.bytes);
+    ASSERT_GT(statistics.seconds, 0.0);
+    ASSERT_GT(statistics.filesPerSecond(), 0.0);
+    ASSERT_GT(statistics.megabytesPerSecond(), 0.0);
+}
+
+// every file is returned once when the results come as they are ready
+TEST(BatchLoader, Completion)
+{
+    vector<string> paths;
+    for( int i = 0; i < 20; ++i )
+    {
+        paths.push_back((i % 2) ? "ducky.obj" : "cube.obj");
+    }
+
+    BatchOptions options;
+    options.ordered = false;
+    options.buildVertexBuffers = false;
+    BatchLoader loader(paths, options);
+
+    set<size_t> indices;
+    BatchResult result;
+    while( loader.next(result) )
+    {
+        ASSERT_TRUE(result.object != nullptr);
+        ASSERT_TRUE(static_cast<const Object&>(*result.object).m_vertexBuffer.empty());
+        ASSERT_TRUE(indices.insert(result.index).second);
+    }
+    ASSERT_EQ(paths.size(), indices.size());
+    ASSERT_FALSE(loader.next(result));
+}
+
+// the files in flight never exceed the limit, except a larger file alone
+TEST(BatchLoader, BoundedMemory)
+{
+    const vector<string> paths = { "cube.obj", "ducky.obj", "cube.obj", "cube.obj", "ducky.obj" };
+
+    BatchOptions options;
+    options.maxBytesInFlight = fileSize("cube.obj") * 2;
+    BatchLoader loader(paths, options);
+
+    BatchResult result;
+    size_t count = 0;
+    while( loader.next(result) )
+    {
+        ASSERT_EQ(count++, result.index);
+    }
+    ASSERT_EQ(paths.size(), count);
+    ASSERT_LE(loader.statistics().peakBytesInFlight,
+              max(fileSize("ducky.obj"), options.maxBytesInFlight));
+
+    // a single file at a time
+    options.maxFilesInFlight = 1;
+    options.maxBytesInFlight = 0;
+    BatchStatistics statistics;
+    loadFiles(paths, options, &statistics);
+    ASSERT_EQ(fileSize("ducky.obj"), statistics.peakBytesInFlight);
+}
+
+TEST(BatchLoader, Cancel)
+{
+    const vector<string> paths(50, "ducky.obj");
+
+    BatchOptions options;
+    options.maxFilesInFlight = 2;
+    BatchLoader loader(paths, options);
+
+    BatchResult result;
+    ASSERT_TRUE(loader.next(result));
+    loader.cancel();
+
+    // only the files already started are returned
+    size_t count = 1;
+    while( loader.next(result) )
+    {
+        ++count;
+    }
+    ASSERT_LE(count, 3);
+}
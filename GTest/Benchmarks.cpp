@@ -0,0 +1,679 @@
+//
+//  Benchmarks.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+//  Benchmarks are disabled by default. Run them with
+//  GTest --gtest_also_run_disabled_tests --gtest_filter=Benchmark*
+//
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "WavefrontFileReader.h"
+#include "BatchLoader.h"
+#include "BinaryCache.h"
+#include "Bvh.h"
+#include "NumberScanner.h"
+#include "LineScanner.h"
+#include "MeshOptimizer.h"
+#include "VertexDedupTable.h"
+#include "VertexWelder.h"
+#include "WavefrontObject.hpp"
+
+using namespace std;
+using namespace WavefrontFileReader;
+
+namespace
+{
+    /// Read the whole file in memory
+    std::string readFile(const std::string& fileName)
+    {
+        ifstream file(fileName, ios::binary);
+        stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    /// Measure how long func runs, in seconds. The best of repeat runs is used
+    template<class Func>
+    double measure(int repeat, Func func)
+    {
+        double best = 1e30;
+        for( int i = 0; i < repeat; ++i )
+        {
+            auto start = chrono::steady_clock::now();
+            func();
+            chrono::duration<double> duration = chrono::steady_clock::now() - start;
+            best = std::min(best, duration.count());
+        }
+        return best;
+    }
+
+    void report(const std::string& name, size_t bytes, double seconds)
+    {
+        cout << "    " << name << ": " << seconds * 1000.0 << " ms, "
+             << (bytes / (1024.0 * 1024.0)) / seconds << " MB/s" << endl;
+    }
+
+    /**
+     * Create a grid of size x size quads with texture coordinates and normals
+     */
+    std::string makeGrid(int size)
+    {
+        stringstream stream;
+        for( int y = 0; y <= size; ++y )
+        {
+            for( int x = 0; x <= size; ++x )
+            {
+                stream << "v " << x << " " << y << " " << ((x * y) % 7) * 0.125 << "\n";
+                stream << "vt " << x / float(size) << " " << y / float(size) << "\n";
+            }
+        }
+        stream << "vn 0 0 1\n";
+        stream << "g grid\n";
+        for( int y = 0; y < size; ++y )
+        {
+            for( int x = 0; x < size; ++x )
+            {
+                const int a = y * (size + 1) + x + 1;
+                const int b = a + 1;
+                const int c = b + size + 1;
+                const int d = a + size + 1;
+                stream << "f " << a << "/" << a << "/1 " << b << "/" << b << "/1 "
+                       << c << "/" << c << "/1 " << d << "/" << d << "/1\n";
+            }
+        }
+        return stream.str();
+    }
+
+    /// Split the content in white space separated tokens
+    std::vector<std::string> splitTokens(const std::string& content,
+                                         const std::string& type)
+    {
+        std::vector<std::string> tokens;
+        stringstream stream(content);
+        std::string line;
+        while( std::getline(stream, line) )
+        {
+            stringstream lineStream(line);
+            std::string token;
+            lineStream >> token;
+            if( token != type )
+            {
+                continue;
+            }
+            while( lineStream >> token )
+            {
+                tokens.push_back(token);
+            }
+        }
+        return tokens;
+    }
+}
+
+// float and index conversion: std::stof / std::strtod against NumberScanner
+TEST(Benchmark, DISABLED_NumberScanning)
+{
+    const std::string content = readFile("ducky.obj");
+    ASSERT_FALSE(content.empty());
+
+    auto floats = splitTokens(content, "v");
+    auto texCoords = splitTokens(content, "vt");
+    floats.insert(floats.end(), texCoords.begin(), texCoords.end());
+    const auto faces = splitTokens(content, "f");
+
+    size_t floatBytes = 0, faceBytes = 0;
+    for( const auto& token : floats ) floatBytes += token.size() + 1;
+    for( const auto& token : faces ) faceBytes += token.size() + 1;
+
+    volatile float floatSink = 0;
+    volatile int intSink = 0;
+
+    cout << "  floats (" << floats.size() << " values)" << endl;
+    report("std::stof", floatBytes, measure(10, [&]() {
+        for( const auto& token : floats ) floatSink = floatSink + std::stof(token);
+    }));
+    report("scanFloat", floatBytes, measure(10, [&]() {
+        float value;
+        for( const auto& token : floats )
+        {
+            scanFloat(token.data(), token.data() + token.size(), value);
+            floatSink = floatSink + value;
+        }
+    }));
+
+    cout << "  face indices (" << faces.size() << " elements)" << endl;
+    report("std::strtod", faceBytes, measure(10, [&]() {
+        for( const auto& token : faces )
+        {
+            char* end = nullptr;
+            int v = int(std::strtod(token.c_str(), &end));
+            int t = (*end == '/') ? int(std::strtod(end + 1, &end)) : 0;
+            int n = (*end == '/') ? int(std::strtod(end + 1, &end)) : 0;
+            intSink = intSink + v + t + n;
+        }
+    }));
+    report("scanIndexData", faceBytes, measure(10, [&]() {
+        IndexData index;
+        for( const auto& token : faces )
+        {
+            scanIndexData(token.data(), token.data() + token.size(), index);
+            intSink = intSink + index.vertexIndex + index.textureIndex + index.normalIndex;
+        }
+    }));
+}
+
+// line splitting and tokenization: std::getline + find_first_of against
+// LineScanner
+TEST(Benchmark, DISABLED_Tokenizer)
+{
+    const std::string content = readFile("ducky.obj");
+    ASSERT_FALSE(content.empty());
+
+    volatile size_t sink = 0;
+
+    report("getline + find_first_of", content.size(), measure(10, [&]() {
+        stringstream stream(content);
+        std::string line;
+        std::vector<std::string> tokens;
+        const std::string delimiters = "\t #";
+        while( std::getline(stream, line) )
+        {
+            tokens.clear();
+            size_t startPos = 0;
+            size_t endPos = line.find_first_of(delimiters);
+            while( endPos != std::string::npos )
+            {
+                if( startPos < endPos )
+                {
+                    tokens.push_back(line.substr(startPos, endPos - startPos));
+                }
+                startPos = endPos + 1;
+                endPos = line.find_first_of(delimiters, startPos);
+            }
+            tokens.push_back(line.substr(startPos));
+            sink = sink + tokens.size();
+        }
+    }));
+    report("LineScanner", content.size(), measure(10, [&]() {
+        std::vector<Token> tokens;
+        LineScanner scanner(content.data(), content.data() + content.size());
+        while( scanner.nextLine(tokens) )
+        {
+            sink = sink + tokens.size();
+        }
+    }));
+}
+
+// whole file parsing
+TEST(Benchmark, DISABLED_LoadFile)
+{
+    const std::string content = readFile("ducky.obj");
+    ASSERT_FALSE(content.empty());
+
+    report("loadFile(istream)", content.size(), measure(10, [&]() {
+        stringstream stream(content);
+        WavefrontFileReader::loadFile(stream);
+    }));
+    report("loadBuffer", content.size(), measure(10, [&]() {
+        WavefrontFileReader::loadBuffer(content.data(), content.size());
+    }));
+    report("loadBufferParallel", content.size(), measure(10, [&]() {
+        WavefrontFileReader::loadBufferParallel(content.data(), content.size());
+    }));
+}
+
+// flat face storage against one vector for every face, on a 1M quads grid
+TEST(Benchmark, DISABLED_FaceStorage)
+{
+    const std::string content = makeGrid(1000);
+
+    std::shared_ptr<IObject> object;
+    report("loadBuffer (FaceList)", content.size(), measure(3, [&]() {
+        object = WavefrontFileReader::loadBuffer(content.data(), content.size());
+    }));
+
+    const auto& faces = object->meshes.front().faces;
+
+    // the layout used before FaceList, built the way the reader did it
+    std::vector<std::vector<IndexData>> legacyFaces;
+    const double legacySeconds = measure(3, [&]() {
+        legacyFaces = std::vector<std::vector<IndexData>>();
+        for( const auto& face : faces )
+        {
+            std::vector<IndexData> indices;
+            for( const auto& index : face.indices )
+            {
+                indices.push_back(index);
+            }
+            legacyFaces.push_back(std::move(indices));
+        }
+    });
+    cout << "    building std::vector<Face>: " << legacySeconds * 1000.0 << " ms" << endl;
+
+    // malloc keeps at least 16 bytes of bookkeeping for every allocation
+    size_t legacyBytes = legacyFaces.capacity() * sizeof(legacyFaces.front());
+    for( const auto& face : legacyFaces )
+    {
+        legacyBytes += face.capacity() * sizeof(IndexData) + 16;
+    }
+
+    cout << "    faces: " << faces.size() << endl;
+    cout << "    FaceList memory: " << faces.memoryUsage() / (1024.0 * 1024.0) << " MB" << endl;
+    cout << "    std::vector<Face> memory: " << legacyBytes / (1024.0 * 1024.0) << " MB" << endl;
+}
+
+namespace
+{
+    /// Hash used by generateVertexBuffers before VertexDedupTable
+    struct XorHash
+    {
+        size_t operator()(const IndexData& k) const
+        {
+            return k.vertexIndex ^ k.normalIndex ^ k.textureIndex;
+        }
+    };
+
+    /// std::hash based combination, a fair std::unordered_map baseline
+    struct CombinedHash
+    {
+        size_t operator()(const IndexData& k) const
+        {
+            size_t h = std::hash<int>()(k.vertexIndex);
+            h ^= std::hash<int>()(k.textureIndex) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            h ^= std::hash<int>()(k.normalIndex) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+
+    /// Corners of a grid of size x size quads, in face order
+    std::vector<IndexData> gridCorners(int size)
+    {
+        std::vector<IndexData> corners;
+        corners.reserve(size_t(size) * size * 4);
+        for( int y = 0; y < size; ++y )
+        {
+            for( int x = 0; x < size; ++x )
+            {
+                const int a = y * (size + 1) + x + 1;
+                for( int corner : { a, a + 1, a + size + 2, a + size + 1 } )
+                {
+                    IndexData index;
+                    index.vertexIndex = corner;
+                    index.textureIndex = corner;
+                    index.normalIndex = 1;
+                    corners.push_back(index);
+                }
+            }
+        }
+        return corners;
+    }
+
+    template<class Map>
+    size_t dedupWithMap(const std::vector<IndexData>& corners, Map& map)
+    {
+        size_t sum = 0;
+        for( const auto& corner : corners )
+        {
+            auto it = map.find(corner);
+            if( it == map.end() )
+            {
+                it = map.insert(std::make_pair(corner, uint32_t(map.size()))).first;
+            }
+            sum += it->second;
+        }
+        return sum;
+    }
+
+    size_t dedupWithTable(const std::vector<IndexData>& corners, VertexDedupTable& table)
+    {
+        size_t sum = 0;
+        bool inserted = false;
+        for( const auto& corner : corners )
+        {
+            sum += table.insert(corner, uint32_t(table.size()), inserted);
+        }
+        return sum;
+    }
+
+    /// Approximate std::unordered_map memory: one allocated node for every
+    /// key and a pointer for every bucket
+    template<class Map>
+    size_t mapMemoryUsage(const Map& map)
+    {
+        return map.size() * (sizeof(void*) + sizeof(typename Map::value_type) + 16) +
+               map.bucket_count() * sizeof(void*);
+    }
+
+    template<class Map>
+    void reportMap(const std::string& name, const std::vector<IndexData>& corners)
+    {
+        Map map;
+        volatile size_t sink = 0;
+        auto start = chrono::steady_clock::now();
+        sink = sink + dedupWithMap(corners, map);
+        chrono::duration<double> duration = chrono::steady_clock::now() - start;
+        cout << "    " << name << ": " << duration.count() * 1000.0 << " ms, "
+             << mapMemoryUsage(map) / (1024.0 * 1024.0) << " MB" << endl;
+    }
+
+    void reportTable(const std::vector<IndexData>& corners, size_t expectedCount)
+    {
+        VertexDedupTable table(expectedCount);
+        volatile size_t sink = 0;
+        auto start = chrono::steady_clock::now();
+        sink = sink + dedupWithTable(corners, table);
+        chrono::duration<double> duration = chrono::steady_clock::now() - start;
+        cout << "    VertexDedupTable: " << duration.count() * 1000.0 << " ms, "
+             << table.memoryUsage() / (1024.0 * 1024.0) << " MB" << endl;
+    }
+}
+
+// vertex deduplication: std::unordered_map against VertexDedupTable
+TEST(Benchmark, DISABLED_VertexDedup)
+{
+    auto object = WavefrontFileReader::loadFile("ducky.obj");
+    std::vector<IndexData> duckyCorners;
+    for( const auto& mesh : object->meshes )
+    {
+        duckyCorners.insert(duckyCorners.end(), mesh.faces.indices().begin(),
+                            mesh.faces.indices().end());
+    }
+
+    cout << "  ducky.obj (" << duckyCorners.size() << " corners)" << endl;
+    reportMap<std::unordered_map<IndexData, uint32_t, XorHash>>("unordered_map, xor hash",
+                                                                duckyCorners);
+    reportMap<std::unordered_map<IndexData, uint32_t, CombinedHash>>("unordered_map, combined hash",
+                                                                     duckyCorners);
+    reportTable(duckyCorners, object->texCoords.size());
+
+    auto& wavefrontObject = static_cast<const Object&>(*object);
+    const double buffersSeconds = measure(10, [&]() {
+        wavefrontObject.generateVertexBuffers(true);
+    });
+    cout << "    generateVertexBuffers: " << buffersSeconds * 1000.0 << " ms" << endl;
+
+    // the xor hash maps every corner of this grid to the same bucket, it is
+    // only measured on a small grid
+    const auto smallGrid = gridCorners(100);
+    cout << "  grid (" << smallGrid.size() << " corners)" << endl;
+    reportMap<std::unordered_map<IndexData, uint32_t, XorHash>>("unordered_map, xor hash",
+                                                                smallGrid);
+    reportTable(smallGrid, 101 * 101);
+
+    const auto grid = gridCorners(1582);
+    cout << "  grid (" << grid.size() << " corners)" << endl;
+    reportMap<std::unordered_map<IndexData, uint32_t, CombinedHash>>("unordered_map, combined hash",
+                                                                     grid);
+    reportTable(grid, 1583 * 1583);
+}
+
+TEST(Benchmark, DISABLED_VertexWelding)
+{
+    for( int size : { 100, 1582, 3000 } )
+    {
+        const auto grid = gridCorners(size);
+        const CornerSegments corners(1, ArrayView<IndexData>(grid.data(),
+                                                             grid.data() + grid.size()));
+        const size_t expectedCount = size_t(size + 1) * (size + 1);
+        cout << "  grid (" << grid.size() << " corners)" << endl;
+
+        WeldResult result;
+        const double hashSeconds = measure(3, [&]() {
+            weldWithHash(corners, expectedCount, result);
+        });
+        cout << "    hash: " << hashSeconds * 1000.0 << " ms, "
+             << result.vertices.size() << " vertices" << endl;
+
+        const double sortSeconds = measure(3, [&]() {
+            weldWithSort(corners, result);
+        });
+        cout << "    radix sort: " << sortSeconds * 1000.0 << " ms, "
+             << result.vertices.size() << " vertices" << endl;
+    }
+}
+
+TEST(Benchmark, DISABLED_ParallelVertexBuffer)
+{
+    auto object = WavefrontFileReader::loadFile("ducky.obj");
+    auto& wavefrontObject = static_cast<const Object&>(*object);
+    cout << "  ducky.obj (" << object->meshes.size() << " meshes)" << endl;
+
+    const double serialSeconds = measure(10, [&]() {
+        wavefrontObject.generateVertexBuffers(true);
+    });
+    cout << "    serial: " << serialSeconds * 1000.0 << " ms" << endl;
+
+    VertexBufferOptions options;
+    options.parallel = true;
+    const double parallelSeconds = measure(10, [&]() {
+        wavefrontObject.generateVertexBuffers(options);
+    });
+    cout << "    parallel: " << parallelSeconds * 1000.0 << " ms" << endl;
+}
+
+TEST(Benchmark, DISABLED_VertexCache)
+{
+    for( const char* fileName : { "ducky.obj", "humanoid_tri.obj" } )
+    {
+        auto object = WavefrontFileReader::loadFile(fileName);
+        auto& wavefrontObject = static_cast<const Object&>(*object);
+
+        wavefrontObject.generateVertexBuffers(true);
+        const auto before = analyzeVertexCache(wavefrontObject.vertexBuffer());
+
+        VertexBufferOptions options;
+        options.optimizeVertexCache = true;
+        const double seconds = measure(3, [&]() {
+            wavefrontObject.generateVertexBuffers(options);
+        });
+        const auto after = analyzeVertexCache(wavefrontObject.vertexBuffer());
+
+        cout << "  " << fileName << " (" << before.triangles << " triangles)" << endl;
+        cout << "    file order: ACMR " << before.acmr << ", ATVR " << before.atvr << endl;
+        cout << "    optimized: ACMR " << after.acmr << ", ATVR " << after.atvr
+             << ", generateVertexBuffers " << seconds * 1000.0 << " ms" << endl;
+    }
+}
+
+TEST(Benchmark, DISABLED_Overdraw)
+{
+    for( const char* fileName : { "ducky.obj", "humanoid_tri.obj" } )
+    {
+        auto object = WavefrontFileReader::loadFile(fileName);
+        auto& wavefrontObject = static_cast<const Object&>(*object);
+
+        VertexBufferOptions options;
+        options.optimizeVertexCache = true;
+        wavefrontObject.generateVertexBuffers(options);
+        const auto cacheBefore = analyzeVertexCache(wavefrontObject.vertexBuffer());
+        const auto before = analyzeOverdraw(wavefrontObject.vertexBuffer());
+
+        options.optimizeOverdraw = true;
+        wavefrontObject.generateVertexBuffers(options);
+        const auto cacheAfter = analyzeVertexCache(wavefrontObject.vertexBuffer());
+        const auto after = analyzeOverdraw(wavefrontObject.vertexBuffer());
+
+        cout << "  " << fileName << endl;
+        cout << "    vertex cache order: overdraw " << before.overdraw
+             << ", ACMR " << cacheBefore.acmr << endl;
+        cout << "    cluster order: overdraw " << after.overdraw
+             << ", ACMR " << cacheAfter.acmr << endl;
+    }
+}
+
+namespace
+{
+    /**
+     * Random triangles inside a cube of the given size, each one smaller
+     * than 1 unit
+     */
+    std::string makeTriangleSoup(int count, float size)
+    {
+        std::mt19937 generator(3);
+        std::uniform_real_distribution<float> position(0.0f, size), offset(-0.5f, 0.5f);
+
+        stringstream stream;
+        for( int i = 0; i < count; ++i )
+        {
+            const float x = position(generator), y = position(generator), z = position(generator);
+            for( int k = 0; k < 3; ++k )
+            {
+                stream << "v " << x + offset(generator) << " " << y + offset(generator) << " "
+                       << z + offset(generator) << "\n";
+            }
+        }
+        stream << "g soup\n";
+        for( int i = 0; i < count; ++i )
+        {
+            stream << "f " << 3 * i + 1 << " " << 3 * i + 2 << " " << 3 * i + 3 << "\n";
+        }
+        return stream.str();
+    }
+
+    /// Build time and closest hit rays per second, with rays between random
+    /// points around and inside the bounds
+    void reportBvh(const std::string& name, const IObject& object)
+    {
+        std::unique_ptr<Bvh> bvh;
+        const double serialSeconds = measure(3, [&]() { bvh.reset(new Bvh(object, 1)); });
+        const double parallelSeconds = measure(3, [&]() { bvh.reset(new Bvh(object)); });
+
+        const Bounds bounds = bvh->bounds();
+        std::mt19937 generator(7);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+        std::vector<Ray> rays(200000);
+        for( auto& ray : rays )
+        {
+            const fvec3 origin = bounds.center + normalize(fvec3(unit(generator), unit(generator),
+                                                                 unit(generator))) * (2.0f * bounds.radius);
+            const fvec3 target = bounds.center + fvec3(unit(generator), unit(generator),
+                                                        unit(generator)) * (0.5f * bounds.radius);
+            ray = Ray(origin, target - origin);
+        }
+
+        size_t hits = 0;
+        const double raySeconds = measure(3, [&]() {
+            hits = 0;
+            RayHit hit;
+            for( const auto& ray : rays )
+            {
+                hits += bvh->intersect(ray, hit) ? 1 : 0;
+            }
+        });
+
+        cout << "  " << name << " (" << bvh->trianglesCount() << " triangles, "
+             << bvh->nodesCount() << " nodes)" << endl;
+        cout << "    build: " << serialSeconds * 1000.0 << " ms on 1 thread, "
+             << parallelSeconds * 1000.0 << " ms on all threads" << endl;
+        cout << "    rays: " << rays.size() / raySeconds / 1e6 << " Mrays/s, "
+             << hits * 100.0 / rays.size() << "% hits" << endl;
+    }
+}
+
+TEST(Benchmark, DISABLED_Bvh)
+{
+    reportBvh("ducky.obj", *WavefrontFileReader::loadFile("ducky.obj"));
+
+    const std::string grid = makeGrid(708);
+    reportBvh("grid", *WavefrontFileReader::loadBuffer(grid.data(), grid.size()));
+
+    const std::string soup = makeTriangleSoup(1000000, 200.0f);
+    reportBvh("triangle soup", *WavefrontFileReader::loadBuffer(soup.data(), soup.size()));
+}
+
+// parsing and building the buffer the renderer draws against mapping its cache
+TEST(Benchmark, DISABLED_BinaryCache)
+{
+    VertexBufferOptions options;
+    options.lodRatios = { 0.5f, 0.25f, 0.1f };
+    options.shortIndices = true;
+    options.splitCommands = true;
+    options.vertexFormat = VertexLayout::Normalized16;
+    options.meshlets = true;
+
+    const std::string content = readFile("ducky.obj");
+    report("loadFile + generateVertexBuffers", content.size(), measure(3, [&]() {
+        auto object = WavefrontFileReader::loadFile("ducky.obj");
+        static_cast<const Object&>(*object).generateVertexBuffers(options);
+    }));
+
+    {
+        ofstream copy("benchmark_ducky.obj", ios::binary | ios::trunc);
+        copy << content;
+    }
+    loadCachedFile("benchmark_ducky.obj", options);
+
+    report("loadCachedFile", content.size(), measure(10, [&]() {
+        loadCachedFile("benchmark_ducky.obj", options);
+    }));
+    report("CacheFile", content.size(), measure(10, [&]() {
+        CacheFile cache(cachePath("benchmark_ducky.obj"));
+        volatile size_t sink = cache.vertexData().size() + cache.indexData().size();
+        (void)sink;
+    }));
+
+    remove(cachePath("benchmark_ducky.obj").c_str());
+    remove("benchmark_ducky.obj");
+}
+
+// building the whole object against only a bounding box from the batches
+TEST(Benchmark, DISABLED_StreamParser)
+{
+    const std::string grid = makeGrid(1000);
+
+    report("loadFile(stream)", grid.size(), measure(3, [&]() {
+        istringstream stream(grid);
+        WavefrontFileReader::loadFile(stream);
+    }));
+    report("parseStream bounds", grid.size(), measure(3, [&]() {
+        istringstream stream(grid);
+        Bounds bounds;
+        StreamHandlers handlers;
+        handlers.vertices = [&bounds](ArrayView<fvec3> vertices) {
+            for( const auto& vertex : vertices )
+            {
+                bounds.low = fvec3(std::min(bounds.low.x, vertex.x), std::min(bounds.low.y, vertex.y),
+                                   std::min(bounds.low.z, vertex.z));
+                bounds.high = fvec3(std::max(bounds.high.x, vertex.x), std::max(bounds.high.y, vertex.y),
+                                    std::max(bounds.high.z, vertex.z));
+            }
+        };
+        parseStream(stream, handlers);
+    }));
+}
+
+// a directory of files loaded one after the other against the batch pipeline
+TEST(Benchmark, DISABLED_BatchLoader)
+{
+    const std::vector<std::string> paths(64, "ducky.obj");
+    const size_t bytes = readFile("ducky.obj").size() * paths.size();
+
+    const double serial = measure(3, [&]() {
+        for( const auto& path : paths )
+        {
+            auto object = WavefrontFileReader::loadFile(path);
+            static_cast<const Object&>(*object).generateVertexBuffers(VertexBufferOptions());
+        }
+    });
+    report("loadFile + generateVertexBuffers", bytes, serial);
+    cout << "    " << paths.size() / serial << " files/s" << endl;
+
+    BatchStatistics statistics;
+    measure(3, [&]() { loadFiles(paths, BatchOptions(), &statistics); });
+    report("loadFiles", statistics.bytes, statistics.seconds);
+    cout << "    " << statistics.filesPerSecond() << " files/s, "
+         << ThreadPool::shared().threadCount() << " threads" << endl;
+}
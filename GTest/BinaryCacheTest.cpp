@@ -0,0 +1,193 @@
+//
+//  BinaryCacheTest.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "WavefrontFileReader.h"
+#include "WavefrontObject.hpp"
+#include "BinaryCache.h"
+
+using namespace std;
+using namespace WavefrontFileReader;
+
+/// Copy a file, the tests don't write next to the shared resources
+static void copyFile(const string& from, const string& to)
+{
+    ifstream input(from, ios::binary);
+    ofstream output(to, ios::binary | ios::trunc);
+    output << input.rdbuf();
+}
+
+static void expectSameBuffer(const VertexBuffer& a, const VertexBuffer& b)
+{
+    ASSERT_TRUE(a.vbo == b.vbo);
+    ASSERT_EQ(a.packedVbo, b.packedVbo);
+    ASSERT_EQ(a.layout.format, b.layout.format);
+    ASSERT_EQ(a.layout.stride, b.layout.stride);
+    ASSERT_EQ(a.ibo, b.ibo);
+    ASSERT_EQ(a.ibo16, b.ibo16);
+    ASSERT_EQ(a.indexSize, b.indexSize);
+    ASSERT_EQ(a.scale, b.scale);
+    ASSERT_EQ(a.commands, b.commands);
+    ASSERT_EQ(a.meshlets.size(), b.meshlets.size());
+    ASSERT_EQ(a.lods.size(), b.lods.size());
+    for( size_t i = 0; i < a.lods.size(); ++i )
+    {
+        ASSERT_EQ(a.lods[i].ratio, b.lods[i].ratio);
+        ASSERT_EQ(a.lods[i].error, b.lods[i].error);
+        ASSERT_EQ(a.lods[i].commands, b.lods[i].commands);
+    }
+    for( size_t i = 0; i < a.commands.size(); ++i )
+    {
+        ASSERT_TRUE(a.commands[i].bounds.low == b.commands[i].bounds.low);
+        ASSERT_TRUE(a.commands[i].bounds.high == b.commands[i].bounds.high);
+    }
+}
+
+// everything saved is mapped back, the arrays are used in place
+TEST(BinaryCache, RoundTrip)
+{
+    auto object = WavefrontFileReader::loadFile("ducky.obj");
+    const Object& wavefrontObject = *(Object*)(object.get());
+
+    VertexBufferOptions options;
+    options.lodRatios = { 0.5f, 0.25f };
+    options.shortIndices = true;
+    options.splitCommands = true;
+    options.vertexFormat = VertexLayout::Normalized16;
+    options.meshlets = true;
+    wavefrontObject.generateVertexBuffers(options);
+    const VertexBuffer& buffer = wavefrontObject.vertexBuffer();
+
+    saveCache("round_trip.cache", buffer, options, object.get(), "ducky.obj");
+    {
+        CacheFile cache("round_trip.cache");
+        ASSERT_TRUE(cache.isValidFor("ducky.obj", options));
+        ASSERT_FALSE(cache.isValidFor("ducky.obj", VertexBufferOptions()));
+        ASSERT_FALSE(cache.isValidFor("cube.obj", options));
+
+        // mapped vertices and indices are the buffer bytes
+        ASSERT_EQ(0, reinterpret_cast<uintptr_t>(cache.vertexData().begin()) % 16);
+        ASSERT_EQ(buffer.packedVbo.size(), cache.vertexData().size());
+        ASSERT_EQ(0, memcmp(buffer.packedVbo.data(), cache.vertexData().begin(),
+                            buffer.packedVbo.size()));
+        ASSERT_EQ(buffer.ibo16.size() * 2, cache.indexData().size());
+        ASSERT_EQ(0, memcmp(buffer.ibo16.data(), cache.indexData().begin(),
+                            cache.indexData().size()));
+
+        expectSameBuffer(buffer, cache.vertexBuffer());
+
+        auto cached = cache.object();
+        ASSERT_TRUE(cached->vertices == object->vertices);
+        ASSERT_TRUE(cached->texCoords == object->texCoords);
+        ASSERT_TRUE(cached->normals == object->normals);
+        ASSERT_TRUE(cached->bounds.low == object->bounds.low);
+        ASSERT_EQ(object->meshes.size(), cached->meshes.size());
+        for( size_t i = 0; i < object->meshes.size(); ++i )
+        {
+            const Mesh& mesh = object->meshes[i];
+            ASSERT_EQ(mesh.name, cached->meshes[i].name);
+            ASSERT_EQ(mesh.numberOfElementsInFace, cached->meshes[i].numberOfElementsInFace);
+            ASSERT_EQ(mesh.faces.indices(), cached->meshes[i].faces.indices());
+            ASSERT_EQ(mesh.faces.offsets(), cached->meshes[i].faces.offsets());
+        }
+        expectSameBuffer(buffer, cached->vertexBuffer());
+    }
+
+    // a buffer without the object
+    saveCache("round_trip.cache", buffer, options, nullptr, "ducky.obj");
+    {
+        CacheFile cache("round_trip.cache");
+        ASSERT_FALSE(cache.hasObject());
+        ASSERT_THROW(cache.object(), std::runtime_error);
+        expectSameBuffer(buffer, cache.vertexBuffer());
+    }
+
+    remove("round_trip.cache");
+}
+
+TEST(BinaryCache, Invalid)
+{
+    ASSERT_THROW(CacheFile("missing.cache"), std::runtime_error);
+
+    {
+        ofstream file("invalid.cache", ios::binary | ios::trunc);
+        file << string(4096, 'x');
+    }
+    ASSERT_THROW(CacheFile("invalid.cache"), std::runtime_error);
+
+    // another version
+    auto object = WavefrontFileReader::loadFile("cube.obj");
+    saveCache("invalid.cache", object->vertexBuffer(), VertexBufferOptions(), object.get(),
+              "cube.obj");
+    {
+        fstream file("invalid.cache", ios::binary | ios::in | ios::out);
+        file.seekp(8);
+        const uint32_t version = kCacheVersion + 1;
+        file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    }
+    ASSERT_THROW(CacheFile("invalid.cache"), std::runtime_error);
+
+    // truncated
+    {
+        ofstream file("invalid.cache", ios::binary | ios::trunc);
+        file << string(64, '\0');
+    }
+    ASSERT_THROW(CacheFile("invalid.cache"), std::runtime_error);
+
+    remove("invalid.cache");
+}
+
+// the cache is used until the file or the options change
+TEST(BinaryCache, LoadCachedFile)
+{
+    copyFile("cube.obj", "cached_cube.obj");
+    remove(cachePath("cached_cube.obj").c_str());
+
+    auto object = loadCachedFile("cached_cube.obj");
+    ASSERT_TRUE(CacheFile(cachePath("cached_cube.obj")).isValidFor("cached_cube.obj",
+                                                                    VertexBufferOptions()));
+
+    auto reference = WavefrontFileReader::loadFile("cube.obj");
+    expectSameBuffer(reference->vertexBuffer(), object->vertexBuffer());
+
+    // the second load reads the cache, a broken cache would be rebuilt
+    auto cached = loadCachedFile("cached_cube.obj");
+    ASSERT_TRUE(cached->vertices == reference->vertices);
+    ASSERT_EQ(reference->meshes.size(), cached->meshes.size());
+    expectSameBuffer(reference->vertexBuffer(), cached->vertexBuffer());
+
+    // other options rebuild it
+    VertexBufferOptions options;
+    options.splitInTriangles = false;
+    auto quads = loadCachedFile("cached_cube.obj", options);
+    static_cast<const Object&>(*reference).generateVertexBuffers(options);
+    expectSameBuffer(reference->vertexBuffer(), quads->vertexBuffer());
+    ASSERT_FALSE(CacheFile(cachePath("cached_cube.obj")).isValidFor("cached_cube.obj",
+                                                                     VertexBufferOptions()));
+    ASSERT_TRUE(CacheFile(cachePath("cached_cube.obj")).isValidFor("cached_cube.obj", options));
+
+    // a changed file too
+    {
+        ofstream file("cached_cube.obj", ios::binary | ios::app);
+        file << "v 100 100 100\n";
+    }
+    ASSERT_FALSE(CacheFile(cachePath("cached_cube.obj")).isValidFor("cached_cube.obj", options));
+    auto changed = loadCachedFile("cached_cube.obj", options);
+    ASSERT_EQ(reference->vertices.size() + 1, changed->vertices.size());
+    ASSERT_TRUE(CacheFile(cachePath("cached_cube.obj")).isValidFor("cached_cube.obj", options));
+
+    remove(cachePath("cached_cube.obj").c_str());
+    remove("cached_cube.obj");
+}
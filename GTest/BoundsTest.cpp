@@ -0,0 +1,111 @@
+//
+//  BoundsTest.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "WavefrontFileReader.h"
+#include "WavefrontObject.hpp"
+#include "Bounds.h"
+
+using namespace std;
+using namespace WavefrontFileReader;
+
+/// Check that bounds contain the point
+static void expectInside(const Bounds& bounds, const fvec3& p)
+{
+    EXPECT_LE(bounds.low.x, p.x);
+    EXPECT_LE(bounds.low.y, p.y);
+    EXPECT_LE(bounds.low.z, p.z);
+    EXPECT_GE(bounds.high.x, p.x);
+    EXPECT_GE(bounds.high.y, p.y);
+    EXPECT_GE(bounds.high.z, p.z);
+    EXPECT_LE(length(p - bounds.center), bounds.radius * 1.0001f);
+}
+
+TEST(Bounds, Empty)
+{
+    const Bounds bounds = computeBounds(nullptr, 0);
+    ASSERT_TRUE(bounds.empty());
+    ASSERT_FALSE(computeBounds(vector<fvec3>(1).data(), 1).empty());
+}
+
+// every number of points uses the SIMD loop and the remaining points
+TEST(Bounds, Points)
+{
+    std::mt19937 generator(5);
+    std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+
+    for( size_t count = 1; count < 40; ++count )
+    {
+        vector<fvec3> points(count);
+        for( auto& p : points )
+        {
+            p = fvec3(distribution(generator), distribution(generator), distribution(generator));
+        }
+
+        fvec3 low = points[0], high = points[0];
+        for( const auto& p : points )
+        {
+            low = fvec3(min(low.x, p.x), min(low.y, p.y), min(low.z, p.z));
+            high = fvec3(max(high.x, p.x), max(high.y, p.y), max(high.z, p.z));
+        }
+
+        const Bounds bounds = computeBounds(points.data(), points.size());
+        ASSERT_TRUE(low == bounds.low);
+        ASSERT_TRUE(high == bounds.high);
+        ASSERT_TRUE((low + high) * 0.5f == bounds.center);
+        for( const auto& p : points )
+        {
+            expectInside(bounds, p);
+        }
+    }
+}
+
+TEST(Bounds, Object)
+{
+    for( bool parallel : { false, true } )
+    {
+        auto object = parallel ? WavefrontFileReader::loadFileParallel("humanoid_quad.obj", 4)
+                               : WavefrontFileReader::loadFile("humanoid_quad.obj");
+        const Object& wavefrontObject = *(Object*)(object.get());
+
+        ASSERT_FALSE(object->bounds.empty());
+        for( const auto& p : object->vertices )
+        {
+            expectInside(object->bounds, p);
+        }
+
+        for( const auto& mesh : object->meshes )
+        {
+            for( const auto& face : mesh.faces )
+            {
+                for( const auto& index : face.indices )
+                {
+                    expectInside(mesh.bounds, object->vertices[index.vertexIndex - 1]);
+                }
+            }
+        }
+
+        // commands have the bounds of their vertices, quads too
+        VertexBufferOptions options;
+        options.splitInTriangles = false;
+        wavefrontObject.generateVertexBuffers(options);
+        const VertexBuffer& buffer = wavefrontObject.vertexBuffer();
+        ASSERT_FALSE(buffer.commands.empty());
+
+        for( const auto& command : buffer.commands )
+        {
+            const Bounds bounds = commandBounds(buffer, command);
+            ASSERT_TRUE(bounds.low == command.bounds.low);
+            ASSERT_TRUE(bounds.high == command.bounds.high);
+            ASSERT_EQ(bounds.radius, command.bounds.radius);
+        }
+    }
+}
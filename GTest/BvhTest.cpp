@@ -0,0 +1,189 @@
+//
+//  BvhTest.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include <random>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "WavefrontFileReader.h"
+#include "Bvh.h"
+
+using namespace std;
+using namespace WavefrontFileReader;
+
+/// Closest hit by testing all the faces of the object
+static bool bruteForce(const IObject& object, const Ray& ray, RayHit& hit)
+{
+    bool found = false;
+    for( uint32_t m = 0; m < object.meshes.size(); ++m )
+    {
+        uint32_t f = 0;
+        for( const auto& face : object.meshes[m].faces )
+        {
+            for( uint32_t k = 0; k + 2 < face.indices.size(); ++k )
+            {
+                const fvec3& a = object.vertices[face.indices[0].vertexIndex - 1];
+                const fvec3 ab = object.vertices[face.indices[k + 1].vertexIndex - 1] - a;
+                const fvec3 ac = object.vertices[face.indices[k + 2].vertexIndex - 1] - a;
+
+                const fvec3 p = cross(ray.direction, ac);
+                const float determinant = dot(ab, p);
+                if( determinant == 0.0f )
+                {
+                    continue;
+                }
+
+                const fvec3 s = ray.origin - a;
+                const float u = dot(s, p) / determinant;
+                const fvec3 q = cross(s, ab);
+                const float v = dot(ray.direction, q) / determinant;
+                const float distance = dot(ac, q) / determinant;
+                if( (u >= 0.0f) && (v >= 0.0f) && (u + v <= 1.0f) && (distance >= 0.0f) &&
+                    (distance < hit.distance) )
+                {
+                    hit.mesh = m;
+                    hit.face = f;
+                    hit.triangle = k;
+                    hit.distance = distance;
+                    found = true;
+                }
+            }
+            ++f;
+        }
+    }
+    return found;
+}
+
+TEST(Bvh, Cube)
+{
+    auto object = WavefrontFileReader::loadFile("cube.obj");
+    const Bvh bvh(*object);
+    ASSERT_GT(bvh.trianglesCount(), 0);
+
+    const Bounds bounds = bvh.bounds();
+    ASSERT_FALSE(bounds.empty());
+
+    // a ray through the center hits the nearest side
+    const fvec3 origin = bounds.center + fvec3(0.0f, 0.0f, 2.0f * bounds.radius);
+    RayHit hit;
+    ASSERT_TRUE(bvh.intersect(Ray(origin, fvec3(0.0f, 0.0f, -1.0f)), hit));
+    ASSERT_NEAR(origin.z - bounds.high.z, hit.distance, 1e-4f);
+    ASSERT_GE(hit.u, 0.0f);
+    ASSERT_GE(hit.v, 0.0f);
+    ASSERT_LE(hit.u + hit.v, 1.0f);
+
+    // the hit point is the barycentric combination of the face corners
+    const auto face = object->meshes[hit.mesh].faces[hit.face];
+    const fvec3& a = object->vertices[face.indices[0].vertexIndex - 1];
+    const fvec3& b = object->vertices[face.indices[hit.triangle + 1].vertexIndex - 1];
+    const fvec3& c = object->vertices[face.indices[hit.triangle + 2].vertexIndex - 1];
+    const fvec3 point = a * (1.0f - hit.u - hit.v) + b * hit.u + c * hit.v;
+    ASSERT_NEAR(bounds.center.x, point.x, 1e-4f);
+    ASSERT_NEAR(bounds.center.y, point.y, 1e-4f);
+    ASSERT_NEAR(bounds.high.z, point.z, 1e-4f);
+
+    // rays away from the cube or stopped before it miss
+    ASSERT_FALSE(bvh.intersect(Ray(origin, fvec3(0.0f, 0.0f, 1.0f)), hit));
+    Ray shortRay(origin, fvec3(0.0f, 0.0f, -1.0f));
+    shortRay.maxDistance = bounds.radius;
+    ASSERT_FALSE(bvh.intersect(shortRay, hit));
+}
+
+// the closest hit is the same as testing all the triangles
+TEST(Bvh, SameAsBruteForce)
+{
+    auto object = WavefrontFileReader::loadFile("ducky.obj");
+    const Bvh bvh(*object);
+    ASSERT_LT(bvh.nodesCount(), 2 * bvh.trianglesCount());
+
+    const Bounds bounds = bvh.bounds();
+    std::mt19937 generator(11);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    size_t hits = 0;
+    for( int i = 0; i < 2000; ++i )
+    {
+        const fvec3 origin = bounds.center + normalize(fvec3(unit(generator), unit(generator),
+                                                             unit(generator))) * (2.0f * bounds.radius);
+        const fvec3 target = bounds.center + fvec3(unit(generator), unit(generator),
+                                                    unit(generator)) * (0.5f * bounds.radius);
+        const Ray ray(origin, target - origin);
+
+        RayHit expected, hit;
+        const bool found = bruteForce(*object, ray, expected);
+        ASSERT_EQ(found, bvh.intersect(ray, hit));
+        if( found )
+        {
+            ASSERT_NEAR(expected.distance, hit.distance, 1e-5f);
+            if( expected.distance != hit.distance )
+            {
+                continue;
+            }
+            ASSERT_EQ(expected.mesh, hit.mesh);
+            ASSERT_EQ(expected.face, hit.face);
+            ASSERT_EQ(expected.triangle, hit.triangle);
+            ++hits;
+        }
+    }
+    ASSERT_GT(hits, 500);
+}
+
+// the tree doesn't depend on the number of threads
+TEST(Bvh, Threads)
+{
+    stringstream stream;
+    const int size = 300;
+    for( int y = 0; y <= size; ++y )
+    {
+        for( int x = 0; x <= size; ++x )
+        {
+            stream << "v " << x << " " << y << " " << ((x * y) % 7) * 0.125 << "\n";
+        }
+    }
+    for( int y = 0; y < size; ++y )
+    {
+        for( int x = 0; x < size; ++x )
+        {
+            const int a = y * (size + 1) + x + 1;
+            stream << "f " << a << " " << a + 1 << " " << a + size + 2 << " " << a + size + 1 << "\n";
+        }
+    }
+
+    auto object = WavefrontFileReader::loadFile(stream);
+    const Bvh serial(*object, 1);
+    const Bvh parallel(*object, 8);
+    ASSERT_EQ(2 * size * size, serial.trianglesCount());
+    ASSERT_EQ(serial.nodesCount(), parallel.nodesCount());
+
+    std::mt19937 generator(5);
+    std::uniform_real_distribution<float> coordinate(0.0f, float(size));
+    for( int i = 0; i < 1000; ++i )
+    {
+        const fvec3 target(coordinate(generator), coordinate(generator), 0.5f);
+        const Ray ray(target + fvec3(0.5f, -0.25f, 10.0f), fvec3(-0.05f, 0.025f, -1.0f));
+
+        RayHit a, b;
+        ASSERT_EQ(serial.intersect(ray, a), parallel.intersect(ray, b));
+        ASSERT_EQ(a.face, b.face);
+        ASSERT_EQ(a.triangle, b.triangle);
+        ASSERT_EQ(a.distance, b.distance);
+    }
+}
+
+TEST(Bvh, Empty)
+{
+    stringstream stream("v 0 0 0\nv 1 0 0\n");
+    auto object = WavefrontFileReader::loadFile(stream);
+    const Bvh bvh(*object);
+    ASSERT_EQ(0, bvh.trianglesCount());
+    ASSERT_TRUE(bvh.bounds().empty());
+
+    RayHit hit;
+    ASSERT_FALSE(bvh.intersect(Ray(fvec3(), fvec3(0.0f, 0.0f, -1.0f)), hit));
+}
@@ -0,0 +1,138 @@
+//
+//  FrustumTest.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include <cmath>
+#include <random>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "WavefrontFileReader.h"
+#include "WavefrontObject.hpp"
+#include "Frustum.h"
+
+using namespace std;
+using namespace WavefrontFileReader;
+
+/// Column major perspective projection looking down -z, like GLKMatrix4MakePerspective
+static void perspective(float fovy, float aspect, float nearZ, float farZ, float matrix[16])
+{
+    const float f = 1.0f / tan(fovy / 2.0f);
+    for( int i = 0; i < 16; ++i )
+    {
+        matrix[i] = 0.0f;
+    }
+    matrix[0] = f / aspect;
+    matrix[5] = f;
+    matrix[10] = (farZ + nearZ) / (nearZ - farZ);
+    matrix[11] = -1.0f;
+    matrix[14] = 2.0f * farZ * nearZ / (nearZ - farZ);
+}
+
+static Bounds makeBox(const fvec3& center, float size)
+{
+    Bounds bounds;
+    bounds.low = center - fvec3(size, size, size);
+    bounds.high = center + fvec3(size, size, size);
+    bounds.center = center;
+    bounds.radius = size * sqrt(3.0f);
+    return bounds;
+}
+
+TEST(Frustum, Perspective)
+{
+    float matrix[16];
+    perspective(1.0f, 1.5f, 0.1f, 100.0f, matrix);
+    const Frustum frustum(matrix);
+
+    ASSERT_TRUE(frustum.intersects(makeBox(fvec3(0, 0, -5), 1)));
+    ASSERT_FALSE(frustum.intersects(makeBox(fvec3(0, 0, 5), 1)));
+    ASSERT_FALSE(frustum.intersects(makeBox(fvec3(100, 0, -5), 1)));
+    ASSERT_FALSE(frustum.intersects(makeBox(fvec3(0, -100, -5), 1)));
+    ASSERT_FALSE(frustum.intersects(makeBox(fvec3(0, 0, -200), 1)));
+
+    // boxes crossing a plane are visible
+    ASSERT_TRUE(frustum.intersects(makeBox(fvec3(0, 0, 0), 1)));
+    ASSERT_TRUE(frustum.intersects(makeBox(fvec3(0, 0, -100), 1)));
+
+    ASSERT_FALSE(frustum.intersects(Bounds()));
+    ASSERT_TRUE(Frustum().intersects(makeBox(fvec3(1e6f, 0, 0), 1)));
+}
+
+// a box is culled when all its corners are outside the same plane
+TEST(Frustum, SameAsCorners)
+{
+    const fvec3 normals[] = { fvec3(1, 0, 0), fvec3(-1, 0.5f, 0), fvec3(0, 1, 0.2f),
+                              fvec3(0.3f, -1, 0), fvec3(0, 0, 1), fvec3(-0.1f, 0.2f, -1) };
+
+    Frustum frustum;
+    for( size_t i = 0; i < 6; ++i )
+    {
+        frustum.setPlane(i, normals[i], 10.0f);
+    }
+
+    std::mt19937 generator(11);
+    std::uniform_real_distribution<float> position(-30.0f, 30.0f);
+    std::uniform_real_distribution<float> size(0.1f, 10.0f);
+
+    for( int test = 0; test < 10000; ++test )
+    {
+        const Bounds box = makeBox(fvec3(position(generator), position(generator),
+                                         position(generator)), size(generator));
+
+        bool outside = false;
+        for( const auto& normal : normals )
+        {
+            bool allOut = true;
+            for( int corner = 0; corner < 8; ++corner )
+            {
+                const fvec3 p((corner & 1) ? box.high.x : box.low.x,
+                              (corner & 2) ? box.high.y : box.low.y,
+                              (corner & 4) ? box.high.z : box.low.z);
+                allOut &= (dot(normal, p) + 10.0f < 0.0f);
+            }
+            outside |= allOut;
+        }
+
+        ASSERT_EQ(!outside, frustum.intersects(box));
+    }
+}
+
+// groups in a row along the x axis
+TEST(Frustum, CullCommands)
+{
+    stringstream stream;
+    for( int i = 0; i < 10; ++i )
+    {
+        stream << "g group" << i << "\n"
+               << "v " << 10 * i << " 0 0\n"
+               << "v " << 10 * i + 1 << " 0 0\n"
+               << "v " << 10 * i << " 1 0\n"
+               << "f " << 3 * i + 1 << " " << 3 * i + 2 << " " << 3 * i + 3 << "\n";
+    }
+
+    auto object = WavefrontFileReader::loadFile(stream);
+    const Object& wavefrontObject = *(Object*)(object.get());
+    const auto& commands = wavefrontObject.vertexBuffer().commands;
+    ASSERT_EQ(10, commands.size());
+
+    // camera at x = 5 looking down -z, sees x in [0, 10] at distance 10
+    float matrix[16];
+    perspective(2.0f * atan(0.5f), 1.0f, 0.1f, 100.0f, matrix);
+    matrix[12] = -5.0f * matrix[0];
+    matrix[14] += -10.0f * matrix[10];
+    matrix[15] = 10.0f;
+
+    vector<uint32_t> visible;
+    ASSERT_EQ(8, cullCommands(commands, Frustum(matrix), visible));
+    ASSERT_EQ((vector<uint32_t>{ 0, 1 }), visible);
+
+    // everything is inside the default frustum
+    ASSERT_EQ(0, cullCommands(commands, Frustum(), visible));
+    ASSERT_EQ(10, visible.size());
+}
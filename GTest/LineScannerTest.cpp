@@ -0,0 +1,155 @@
+//
+//  LineScannerTest.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "LineScanner.h"
+
+using namespace std;
+using namespace WavefrontFileReader;
+
+namespace
+{
+    /// Scan the whole buffer and return the tokens from every line
+    std::vector<std::vector<std::string>> scan(const std::vector<char>& buffer)
+    {
+        std::vector<std::vector<std::string>> lines;
+        std::vector<Token> tokens;
+
+        LineScanner scanner(buffer.data(), buffer.data() + buffer.size());
+        while( scanner.nextLine(tokens) )
+        {
+            lines.push_back(std::vector<std::string>());
+            for( const auto& token : tokens )
+            {
+                EXPECT_TRUE(token.begin >= buffer.data());
+                EXPECT_TRUE(token.end <= buffer.data() + buffer.size());
+                lines.back().push_back(std::string(token.begin, token.end));
+            }
+        }
+        EXPECT_EQ(buffer.data() + buffer.size(), scanner.position());
+
+        return lines;
+    }
+
+    /// Character by character tokenizer used as reference
+    std::vector<std::vector<std::string>> reference(const std::string& content)
+    {
+        std::vector<std::vector<std::string>> lines;
+        if( content.empty() )
+        {
+            return lines;
+        }
+
+        lines.push_back(std::vector<std::string>());
+        std::string token;
+        bool comment = false;
+        for( size_t i = 0; i < content.size(); ++i )
+        {
+            const char c = content[i];
+            const bool delimiter = (c == ' ') || (c == '\t') || (c == '\r') ||
+                                   (c == '\n') || (c == '#');
+            if( delimiter && !token.empty() )
+            {
+                lines.back().push_back(token);
+                token.clear();
+            }
+            if( c == '#' )
+            {
+                comment = true;
+            }
+            if( c == '\n' )
+            {
+                comment = false;
+                if( i + 1 < content.size() )
+                {
+                    lines.push_back(std::vector<std::string>());
+                }
+            }
+            else if( !delimiter && !comment )
+            {
+                token += c;
+            }
+        }
+        if( !token.empty() )
+        {
+            lines.back().push_back(token);
+        }
+        return lines;
+    }
+
+    std::vector<char> toBuffer(const std::string& content)
+    {
+        // no null terminator, so reading past the end is detected by tools
+        return std::vector<char>(content.begin(), content.end());
+    }
+}
+
+TEST(LineScanner, Empty)
+{
+    std::vector<char> buffer;
+    ASSERT_TRUE(scan(buffer).empty());
+}
+
+TEST(LineScanner, Lines)
+{
+    const std::string content = "v 1 2 3\r\n"
+                                "\n"
+                                "  # comment line\n"
+                                "\tvt 0.5\t0.25 # 4 5\n"
+                                "g  name#no space\n"
+                                "f 1/1/1 2/2/2 3/3/3";
+
+    auto lines = scan(toBuffer(content));
+    ASSERT_EQ(6, lines.size());
+    ASSERT_EQ((std::vector<std::string>{ "v", "1", "2", "3" }), lines[0]);
+    ASSERT_TRUE(lines[1].empty());
+    ASSERT_TRUE(lines[2].empty());
+    ASSERT_EQ((std::vector<std::string>{ "vt", "0.5", "0.25" }), lines[3]);
+    ASSERT_EQ((std::vector<std::string>{ "g", "name" }), lines[4]);
+    ASSERT_EQ((std::vector<std::string>{ "f", "1/1/1", "2/2/2", "3/3/3" }), lines[5]);
+}
+
+// tokens, comments and lines that cross the 64 bytes blocks
+TEST(LineScanner, LongTokens)
+{
+    const std::string longToken(150, 'x');
+    const std::string content = "a " + longToken + " b\n#" + longToken + "\n" + longToken;
+
+    auto lines = scan(toBuffer(content));
+    ASSERT_EQ(3, lines.size());
+    ASSERT_EQ((std::vector<std::string>{ "a", longToken, "b" }), lines[0]);
+    ASSERT_TRUE(lines[1].empty());
+    ASSERT_EQ((std::vector<std::string>{ longToken }), lines[2]);
+}
+
+TEST(LineScanner, Random)
+{
+    const char alphabet[] = { 'v', 'f', '1', '.', '/', '-', ' ', ' ', '\t', '\r', '\n', '\n', '#' };
+
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> character(0, sizeof(alphabet) - 1);
+    std::uniform_int_distribution<int> length(0, 300);
+
+    for( int i = 0; i < 2000; ++i )
+    {
+        std::string content;
+        const int size = length(generator);
+        for( int j = 0; j < size; ++j )
+        {
+            content += alphabet[character(generator)];
+        }
+
+        ASSERT_EQ(reference(content), scan(toBuffer(content))) << content;
+    }
+}
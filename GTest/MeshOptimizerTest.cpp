@@ -0,0 +1,323 @@
+//
+//  MeshOptimizerTest.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <array>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "WavefrontFileReader.h"
+#include "WavefrontObject.hpp"
+#include "MeshOptimizer.h"
+
+using namespace std;
+using namespace WavefrontFileReader;
+
+typedef array<Vertex, 3> Triangle;
+
+/// Compare all the vertex attributes
+static bool vertexLess(const Vertex& a, const Vertex& b)
+{
+    const float left[] = { a.position.x, a.position.y, a.position.z,
+                           a.normal.x, a.normal.y, a.normal.z,
+                           a.texture.x, a.texture.y, a.texture.z };
+    const float right[] = { b.position.x, b.position.y, b.position.z,
+                            b.normal.x, b.normal.y, b.normal.z,
+                            b.texture.x, b.texture.y, b.texture.z };
+    return lexicographical_compare(left, left + 9, right, right + 9);
+}
+
+/// Triangles drawn by the buffer, sorted. Triangles are rotated to start with
+/// the smallest vertex so the winding is kept
+static vector<Triangle> drawnTriangles(const VertexBuffer& buffer)
+{
+    vector<Triangle> result;
+    for( const auto& command : buffer.commands )
+    {
+        for( uint32_t i = command.index; i + 2 < command.index + command.count; i += 3 )
+        {
+            Triangle triangle = { buffer.vbo[buffer.index(i) + command.baseVertex],
+                                  buffer.vbo[buffer.index(i + 1) + command.baseVertex],
+                                  buffer.vbo[buffer.index(i + 2) + command.baseVertex] };
+            rotate(triangle.begin(),
+                   min_element(triangle.begin(), triangle.end(), vertexLess),
+                   triangle.end());
+            result.push_back(triangle);
+        }
+    }
+
+    sort(result.begin(), result.end(), [](const Triangle& a, const Triangle& b) {
+        return lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), vertexLess);
+    });
+    return result;
+}
+
+/// Grid of size x size quads split in triangles, in random order
+static VertexBuffer makeShuffledGrid(int size)
+{
+    VertexBuffer buffer;
+    for( int y = 0; y <= size; ++y )
+    {
+        for( int x = 0; x <= size; ++x )
+        {
+            Vertex vertex;
+            vertex.position = fvec3(float(x), float(y), 0.0f);
+            buffer.vbo.push_back(vertex);
+        }
+    }
+
+    vector<array<uint32_t, 3>> triangles;
+    for( int y = 0; y < size; ++y )
+    {
+        for( int x = 0; x < size; ++x )
+        {
+            const uint32_t a = y * (size + 1) + x;
+            triangles.push_back({ a, a + 1, a + size + 2 });
+            triangles.push_back({ a, a + size + 2, a + size + 1 });
+        }
+    }
+    shuffle(triangles.begin(), triangles.end(), mt19937(3));
+
+    for( const auto& triangle : triangles )
+    {
+        buffer.ibo.insert(buffer.ibo.end(), triangle.begin(), triangle.end());
+    }
+
+    Command command;
+    command.count = (uint32_t)buffer.ibo.size();
+    buffer.commands.push_back(command);
+    return buffer;
+}
+
+TEST(MeshOptimizer, AnalyzeVertexCache)
+{
+    VertexBuffer buffer;
+    buffer.vbo.resize(4);
+    buffer.ibo = { 0, 1, 2, 2, 1, 3 };
+    buffer.commands.resize(1);
+    buffer.commands[0].count = 6;
+
+    const auto statistics = analyzeVertexCache(buffer);
+    ASSERT_EQ(2, statistics.triangles);
+    ASSERT_EQ(4, statistics.vertices);
+    ASSERT_EQ(4, statistics.transforms);
+    ASSERT_FLOAT_EQ(2.0f, statistics.acmr);
+    ASSERT_FLOAT_EQ(1.0f, statistics.atvr);
+
+    // only the repeated vertex 2 is still in a single vertex cache
+    const auto small = analyzeVertexCache(buffer, 1);
+    ASSERT_EQ(5, small.transforms);
+}
+
+TEST(MeshOptimizer, VertexCacheGrid)
+{
+    VertexBuffer buffer = makeShuffledGrid(60);
+    const auto before = analyzeVertexCache(buffer);
+    const auto triangles = drawnTriangles(buffer);
+
+    optimizeVertexCache(buffer);
+    const auto after = analyzeVertexCache(buffer);
+
+    ASSERT_TRUE(triangles == drawnTriangles(buffer));
+    ASSERT_EQ(before.triangles, after.triangles);
+    ASSERT_GT(before.acmr, 2.0f);
+    ASSERT_LT(after.acmr, 0.8f);
+}
+
+TEST(MeshOptimizer, VertexCacheDucky)
+{
+    auto object = WavefrontFileReader::loadFile("ducky.obj");
+    const Object& wavefrontObject = *(Object*)(object.get());
+
+    const VertexBuffer original = wavefrontObject.vertexBuffer();
+    const auto before = analyzeVertexCache(original);
+
+    VertexBufferOptions options;
+    options.optimizeVertexCache = true;
+    wavefrontObject.generateVertexBuffers(options);
+    const VertexBuffer& buffer = wavefrontObject.vertexBuffer();
+    const auto after = analyzeVertexCache(buffer);
+
+    ASSERT_EQ(original.commands, buffer.commands);
+    ASSERT_TRUE(drawnTriangles(original) == drawnTriangles(buffer));
+    ASSERT_LT(after.acmr, before.acmr);
+    ASSERT_LT(after.atvr, before.atvr);
+}
+
+TEST(MeshOptimizer, VertexFetch)
+{
+    auto object = WavefrontFileReader::loadFile("ducky.obj");
+    const Object& wavefrontObject = *(Object*)(object.get());
+
+    const VertexBuffer original = wavefrontObject.vertexBuffer();
+
+    VertexBufferOptions options;
+    options.optimizeVertexCache = true;
+    options.optimizeVertexFetch = true;
+    wavefrontObject.generateVertexBuffers(options);
+    const VertexBuffer& buffer = wavefrontObject.vertexBuffer();
+
+    ASSERT_EQ(original.vbo.size(), buffer.vbo.size());
+    ASSERT_TRUE(drawnTriangles(original) == drawnTriangles(buffer));
+
+    // every index is a vertex used before or the next one
+    uint32_t next = 0;
+    for( const auto index : buffer.ibo )
+    {
+        ASSERT_LE(index, next);
+        next = max(next, index + 1);
+    }
+}
+
+TEST(MeshOptimizer, VertexFetchRemovesUnused)
+{
+    VertexBuffer buffer;
+    for( int i = 0; i < 5; ++i )
+    {
+        Vertex vertex;
+        vertex.position = fvec3(float(i), 0.0f, 0.0f);
+        buffer.vbo.push_back(vertex);
+    }
+    buffer.ibo = { 4, 2, 3, 3, 2, 0 };
+    buffer.commands.resize(1);
+    buffer.commands[0].count = 6;
+
+    optimizeVertexFetch(buffer);
+
+    const vector<uint32_t> expectedIndices = { 0, 1, 2, 2, 1, 3 };
+    ASSERT_EQ(expectedIndices, buffer.ibo);
+    ASSERT_EQ(4, buffer.vbo.size());
+    ASSERT_EQ(4.0f, buffer.vbo[0].position.x);
+    ASSERT_EQ(2.0f, buffer.vbo[1].position.x);
+    ASSERT_EQ(3.0f, buffer.vbo[2].position.x);
+    ASSERT_EQ(0.0f, buffer.vbo[3].position.x);
+}
+
+/// Square in the z plane, made of two triangles
+static void addSquare(VertexBuffer& buffer, float size, float z)
+{
+    const uint32_t first = (uint32_t)buffer.vbo.size();
+    const float corners[][2] = { { -size, -size }, { size, -size }, { size, size }, { -size, size } };
+    for( const auto& corner : corners )
+    {
+        Vertex vertex;
+        vertex.position = fvec3(corner[0], corner[1], z);
+        buffer.vbo.push_back(vertex);
+    }
+
+    for( uint32_t index : { 0, 1, 2, 0, 2, 3 } )
+    {
+        buffer.ibo.push_back(first + index);
+    }
+}
+
+/// Sphere made of latitude and longitude quads, split in triangles
+static void addSphere(VertexBuffer& buffer, float radius)
+{
+    const int rings = 24, segments = 48;
+    const uint32_t first = (uint32_t)buffer.vbo.size();
+
+    for( int r = 0; r <= rings; ++r )
+    {
+        const float theta = float(M_PI) * r / rings;
+        for( int s = 0; s <= segments; ++s )
+        {
+            const float phi = 2.0f * float(M_PI) * s / segments;
+            Vertex vertex;
+            vertex.position = fvec3(radius * sin(theta) * cos(phi), radius * sin(theta) * sin(phi),
+                                    radius * cos(theta));
+            buffer.vbo.push_back(vertex);
+        }
+    }
+
+    for( int r = 0; r < rings; ++r )
+    {
+        for( int s = 0; s < segments; ++s )
+        {
+            const uint32_t a = first + r * (segments + 1) + s;
+            const uint32_t b = a + segments + 1;
+            for( uint32_t index : { a, b, a + 1, a + 1, b, b + 1 } )
+            {
+                buffer.ibo.push_back(index);
+            }
+        }
+    }
+}
+
+static void addCommand(VertexBuffer& buffer)
+{
+    Command command;
+    command.count = (uint32_t)buffer.ibo.size();
+    buffer.commands.assign(1, command);
+}
+
+TEST(MeshOptimizer, AnalyzeOverdraw)
+{
+    VertexBuffer square;
+    addSquare(square, 1.0f, 0.0f);
+    addCommand(square);
+
+    const auto single = analyzeOverdraw(square, 64);
+    ASSERT_GT(single.covered, 0);
+    ASSERT_FLOAT_EQ(1.0f, single.overdraw);
+
+    // from half of the directions the second square is in front of the
+    // first one, the draw order doesn't matter
+    VertexBuffer squares;
+    addSquare(squares, 1.0f, 0.0f);
+    addSquare(squares, 1.0f, 0.5f);
+    addCommand(squares);
+
+    const auto twoSquares = analyzeOverdraw(squares, 64);
+    ASSERT_GT(twoSquares.overdraw, 1.1f);
+    ASSERT_LT(twoSquares.overdraw, 1.5f);
+
+    std::reverse(squares.ibo.begin(), squares.ibo.end());
+    ASSERT_EQ(twoSquares.shaded, analyzeOverdraw(squares, 64).shaded);
+}
+
+// the outer sphere hides the inner one, it should be drawn first
+TEST(MeshOptimizer, OverdrawNestedSpheres)
+{
+    VertexBuffer buffer;
+    addSphere(buffer, 0.5f);
+    addSphere(buffer, 1.0f);
+    addCommand(buffer);
+
+    optimizeVertexCache(buffer);
+    const auto triangles = drawnTriangles(buffer);
+    const auto before = analyzeOverdraw(buffer, 128);
+
+    optimizeOverdraw(buffer);
+    const auto after = analyzeOverdraw(buffer, 128);
+
+    ASSERT_TRUE(triangles == drawnTriangles(buffer));
+    ASSERT_EQ(before.covered, after.covered);
+    ASSERT_LT(after.overdraw, before.overdraw);
+}
+
+TEST(MeshOptimizer, OverdrawDucky)
+{
+    auto object = WavefrontFileReader::loadFile("ducky.obj");
+    const Object& wavefrontObject = *(Object*)(object.get());
+
+    VertexBufferOptions options;
+    options.optimizeVertexCache = true;
+    wavefrontObject.generateVertexBuffers(options);
+    const VertexBuffer original = wavefrontObject.vertexBuffer();
+
+    options.optimizeOverdraw = true;
+    wavefrontObject.generateVertexBuffers(options);
+    const VertexBuffer& buffer = wavefrontObject.vertexBuffer();
+
+    ASSERT_TRUE(drawnTriangles(original) == drawnTriangles(buffer));
+    ASSERT_LE(analyzeOverdraw(buffer, 128).overdraw, analyzeOverdraw(original, 128).overdraw);
+    ASSERT_LT(analyzeVertexCache(buffer).acmr, analyzeVertexCache(original).acmr * 1.1f);
+}
@@ -0,0 +1,150 @@
+//
+//  MeshletsTest.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include "WavefrontFileReader.h"
+#include "WavefrontObject.hpp"
+#include "Meshlets.h"
+#include "MeshOptimizer.h"
+
+using namespace std;
+using namespace WavefrontFileReader;
+
+static VertexBuffer duckyBuffer(bool shortIndices)
+{
+    auto object = WavefrontFileReader::loadFile("ducky.obj");
+    const Object& wavefrontObject = *(Object*)(object.get());
+
+    VertexBufferOptions options;
+    options.optimizeVertexCache = true;
+    options.shortIndices = shortIndices;
+    options.meshlets = true;
+    wavefrontObject.generateVertexBuffers(options);
+    return wavefrontObject.vertexBuffer();
+}
+
+TEST(Meshlets, Ducky)
+{
+    for( bool shortIndices : { false, true } )
+    {
+        const VertexBuffer buffer = duckyBuffer(shortIndices);
+        const auto positions = buffer.vbo;
+        ASSERT_FALSE(buffer.meshlets.empty());
+
+        // meshlets cover the commands, in order and without gaps
+        size_t meshlet = 0;
+        for( uint32_t c = 0; c < buffer.commands.size(); ++c )
+        {
+            const Command& command = buffer.commands[c];
+            uint32_t index = command.index;
+
+            for( ; (meshlet < buffer.meshlets.size()) &&
+                   (buffer.meshlets[meshlet].command == c); ++meshlet )
+            {
+                const Meshlet& m = buffer.meshlets[meshlet];
+                ASSERT_EQ(index, m.index);
+                ASSERT_EQ(0, m.count % 3);
+                ASSERT_LE(m.count / 3, kMeshletMaxTriangles);
+                index += m.count;
+
+                set<uint32_t> vertices;
+                for( uint32_t i = m.index; i < m.index + m.count; ++i )
+                {
+                    const uint32_t vertex = buffer.index(i) + command.baseVertex;
+                    vertices.insert(vertex);
+
+                    // the sphere contains all the vertices
+                    ASSERT_LE(length(positions[vertex].position - m.center), m.radius * 1.0001f);
+                }
+                ASSERT_EQ(vertices.size(), m.verticesCount);
+                ASSERT_LE(m.verticesCount, kMeshletMaxVertices);
+
+                // the cone contains all the triangle normals
+                if( m.coneCutoff < 1.0f )
+                {
+                    const float minimumDot = sqrt(1.0f - m.coneCutoff * m.coneCutoff);
+                    for( uint32_t i = m.index; i < m.index + m.count; i += 3 )
+                    {
+                        const fvec3& a = positions[buffer.index(i) + command.baseVertex].position;
+                        const fvec3& b = positions[buffer.index(i + 1) + command.baseVertex].position;
+                        const fvec3& c = positions[buffer.index(i + 2) + command.baseVertex].position;
+                        const fvec3 normal = normalize(cross(b - a, c - a));
+                        if( length(normal) > 0.0f )
+                        {
+                            ASSERT_GE(dot(normal, m.coneAxis), minimumDot - 1e-4f);
+                        }
+                    }
+                }
+            }
+
+            ASSERT_EQ(command.index + command.count, index);
+        }
+        ASSERT_EQ(buffer.meshlets.size(), meshlet);
+    }
+}
+
+TEST(Meshlets, Limits)
+{
+    VertexBuffer buffer = duckyBuffer(false);
+    buildMeshlets(buffer, 16, 8);
+
+    for( const auto& meshlet : buffer.meshlets )
+    {
+        ASSERT_LE(meshlet.verticesCount, 16);
+        ASSERT_LE(meshlet.count, 8 * 3);
+    }
+}
+
+// a culled meshlet has all the triangles facing away from the camera
+TEST(Meshlets, BackFacing)
+{
+    const VertexBuffer buffer = duckyBuffer(false);
+    const auto& vbo = buffer.vbo;
+
+    const fvec3 cameras[] = { fvec3(0, 0, 500), fvec3(0, 0, -500), fvec3(300, 200, 100) };
+    for( const auto& camera : cameras )
+    {
+        size_t culled = 0;
+        for( const auto& meshlet : buffer.meshlets )
+        {
+            if( !isBackFacing(meshlet, camera) )
+            {
+                continue;
+            }
+            ++culled;
+
+            for( uint32_t i = meshlet.index; i < meshlet.index + meshlet.count; i += 3 )
+            {
+                const fvec3& a = vbo[buffer.ibo[i]].position;
+                const fvec3& b = vbo[buffer.ibo[i + 1]].position;
+                const fvec3& c = vbo[buffer.ibo[i + 2]].position;
+                ASSERT_GE(dot(cross(b - a, c - a), a - camera), 0.0f);
+            }
+        }
+        ASSERT_GT(culled, 0);
+    }
+}
+
+// the passes that move triangles drop the meshlets
+TEST(Meshlets, InvalidatedByReorder)
+{
+    auto object = WavefrontFileReader::loadFile("ducky.obj");
+    const Object& wavefrontObject = *(Object*)(object.get());
+
+    VertexBufferOptions options;
+    options.meshlets = true;
+    wavefrontObject.generateVertexBuffers(options);
+    VertexBuffer buffer = wavefrontObject.vertexBuffer();
+    ASSERT_FALSE(buffer.meshlets.empty());
+
+    optimizeVertexCache(buffer);
+    ASSERT_TRUE(buffer.meshlets.empty());
+}
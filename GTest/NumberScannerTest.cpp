@@ -0,0 +1,145 @@
+//
+//  NumberScannerTest.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+
+#include "NumberScanner.h"
+
+using namespace std;
+using namespace WavefrontFileReader;
+
+// parse a null terminated string with scanFloat and check the result against
+// strtof, which is correctly rounded
+static void checkFloat(const std::string& str)
+{
+    float value = 1.0f;
+    const char* end = scanFloat(str.data(), str.data() + str.size(), value);
+
+    char* expectedEnd = nullptr;
+    float expected = std::strtof(str.c_str(), &expectedEnd);
+
+    ASSERT_EQ(expectedEnd - str.c_str(), end - str.data()) << str;
+    ASSERT_EQ(0, memcmp(&expected, &value, sizeof(float))) << str;
+}
+
+TEST(NumberScanner, FloatValues)
+{
+    for( auto str : { "0", "-0", "1", "-1", "0.5", "+0.5", ".5", "5.", "-.25",
+                      "0.000000", "-0.500000", "140.987503", "29.564405",
+                      "1e3", "1E-3", "-1.25e-1", "3.4028235e38", "1e39",
+                      "1.17549435e-38", "1e-40", "1e-50", "123456789012345678901234",
+                      "0.1234567890123456789012", "16777217", "2.00000012",
+                      "1.00000005960464477539062", "1.5e", "2e+", "7x" } )
+    {
+        checkFloat(str);
+    }
+}
+
+// values that are exactly halfway between two floats need the slow path
+TEST(NumberScanner, FloatHalfway)
+{
+    // 2^24 + 1 and (2^24 + 1) / 2^10 are halfway between two floats
+    checkFloat("16777217");
+    checkFloat("16384.0009765625");
+    checkFloat("-16384.0009765625");
+}
+
+TEST(NumberScanner, FloatRandom)
+{
+    std::mt19937 generator(1234);
+    std::uniform_int_distribution<int> digitsCount(1, 20);
+    std::uniform_int_distribution<int> digit(0, 9);
+    std::uniform_int_distribution<int> exponent(-45, 39);
+
+    for( int i = 0; i < 200000; ++i )
+    {
+        std::string str;
+        if( digit(generator) < 5 )
+        {
+            str += '-';
+        }
+
+        const int integerDigits = digitsCount(generator) / 4;
+        const int fractionalDigits = digitsCount(generator);
+        for( int j = 0; j < integerDigits; ++j )
+        {
+            str += char('0' + digit(generator));
+        }
+        str += '.';
+        for( int j = 0; j < fractionalDigits; ++j )
+        {
+            str += char('0' + digit(generator));
+        }
+        if( digit(generator) < 3 )
+        {
+            str += "e" + std::to_string(exponent(generator));
+        }
+
+        checkFloat(str);
+    }
+}
+
+TEST(NumberScanner, NotANumber)
+{
+    float value = 1.0f;
+    const std::string str = "abc";
+    ASSERT_EQ(str.data(), scanFloat(str.data(), str.data() + str.size(), value));
+    ASSERT_EQ(0.0f, value);
+
+    int index = 1;
+    ASSERT_EQ(str.data(), scanInt(str.data(), str.data() + str.size(), index));
+    ASSERT_EQ(0, index);
+}
+
+TEST(NumberScanner, Integers)
+{
+    const std::string str = "12345 -17 0";
+
+    int value = 0;
+    const char* ptr = scanInt(str.data(), str.data() + str.size(), value);
+    ASSERT_EQ(12345, value);
+    ptr = scanInt(ptr + 1, str.data() + str.size(), value);
+    ASSERT_EQ(-17, value);
+    ptr = scanInt(ptr + 1, str.data() + str.size(), value);
+    ASSERT_EQ(0, value);
+    ASSERT_EQ(str.data() + str.size(), ptr);
+}
+
+TEST(NumberScanner, IndexData)
+{
+    IndexData index;
+
+    const std::string full = "3/12/7";
+    scanIndexData(full.data(), full.data() + full.size(), index);
+    ASSERT_EQ(3, index.vertexIndex);
+    ASSERT_EQ(12, index.textureIndex);
+    ASSERT_EQ(7, index.normalIndex);
+
+    const std::string noTexture = "3//7";
+    scanIndexData(noTexture.data(), noTexture.data() + noTexture.size(), index);
+    ASSERT_EQ(3, index.vertexIndex);
+    ASSERT_EQ(0, index.textureIndex);
+    ASSERT_EQ(7, index.normalIndex);
+
+    const std::string vertexOnly = "42";
+    scanIndexData(vertexOnly.data(), vertexOnly.data() + vertexOnly.size(), index);
+    ASSERT_EQ(42, index.vertexIndex);
+    ASSERT_EQ(0, index.textureIndex);
+    ASSERT_EQ(0, index.normalIndex);
+
+    // the range ends before the normal index
+    scanIndexData(full.data(), full.data() + 4, index);
+    ASSERT_EQ(3, index.vertexIndex);
+    ASSERT_EQ(12, index.textureIndex);
+    ASSERT_EQ(0, index.normalIndex);
+}
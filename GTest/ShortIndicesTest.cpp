@@ -0,0 +1,115 @@
+//
+//  ShortIndicesTest.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+
+#include "WavefrontFileReader.h"
+#include "WavefrontObject.hpp"
+#include "ShortIndices.h"
+
+using namespace std;
+using namespace WavefrontFileReader;
+
+/// Indices of buffer with the base vertex of their command added
+static vector<uint32_t> absoluteIndices(const VertexBuffer& buffer)
+{
+    vector<uint32_t> indices(buffer.indicesCount());
+    for( const auto& command : buffer.commands )
+    {
+        for( uint32_t i = command.index; i < command.index + command.count; ++i )
+        {
+            indices[i] = buffer.index(i) + command.baseVertex;
+        }
+    }
+    return indices;
+}
+
+/// Triangles that connect vertices far apart, like a long triangle strip
+static VertexBuffer makeLongStrip(uint32_t verticesCount)
+{
+    VertexBuffer buffer;
+    buffer.vbo.resize(verticesCount);
+    for( uint32_t i = 0; i + 2 < verticesCount; ++i )
+    {
+        buffer.ibo.push_back(i);
+        buffer.ibo.push_back(i + 1);
+        buffer.ibo.push_back(i + 2);
+    }
+
+    Command command;
+    command.count = (uint32_t)buffer.ibo.size();
+    buffer.commands.push_back(command);
+    return buffer;
+}
+
+TEST(ShortIndices, Ducky)
+{
+    auto object = WavefrontFileReader::loadFile("ducky.obj");
+    const Object& wavefrontObject = *(Object*)(object.get());
+
+    const VertexBuffer original = wavefrontObject.vertexBuffer();
+
+    VertexBufferOptions options;
+    options.shortIndices = true;
+    wavefrontObject.generateVertexBuffers(options);
+    const VertexBuffer& buffer = wavefrontObject.vertexBuffer();
+
+    ASSERT_EQ(2, buffer.indexSize);
+    ASSERT_TRUE(buffer.ibo.empty());
+    ASSERT_EQ(original.ibo.size(), buffer.ibo16.size());
+    ASSERT_EQ(original.commands.size(), buffer.commands.size());
+    ASSERT_TRUE(original.vbo == buffer.vbo);
+    ASSERT_EQ(original.ibo, absoluteIndices(buffer));
+}
+
+TEST(ShortIndices, TooManyVertices)
+{
+    VertexBuffer buffer = makeLongStrip(100000);
+    const VertexBuffer original = buffer;
+
+    ASSERT_FALSE(convertToShortIndices(buffer, false));
+    ASSERT_EQ(4, buffer.indexSize);
+    ASSERT_EQ(original.ibo, buffer.ibo);
+    ASSERT_EQ(original.commands, buffer.commands);
+}
+
+TEST(ShortIndices, SplitCommands)
+{
+    VertexBuffer buffer = makeLongStrip(200000);
+    for( size_t i = 0; i < buffer.vbo.size(); ++i )
+    {
+        buffer.vbo[i].position = fvec3(float(i), 0.0f, 0.0f);
+    }
+    const VertexBuffer original = buffer;
+
+    ASSERT_TRUE(convertToShortIndices(buffer, true));
+    ASSERT_EQ(2, buffer.indexSize);
+    ASSERT_EQ(4, buffer.commands.size());
+
+    // commands cover the original command without gaps and whole triangles
+    uint32_t index = 0;
+    for( const auto& command : buffer.commands )
+    {
+        ASSERT_EQ(index, command.index);
+        ASSERT_EQ(0, command.count % 3);
+        index += command.count;
+
+        uint32_t last = 0;
+        for( uint32_t i = command.index; i < command.index + command.count; ++i )
+        {
+            ASSERT_LT(buffer.ibo16[i], kMaxShortIndexVertices);
+            last = max<uint32_t>(last, buffer.ibo16[i] + command.baseVertex);
+        }
+
+        // split commands have their own bounds
+        ASSERT_EQ(float(command.baseVertex), command.bounds.low.x);
+        ASSERT_EQ(float(last), command.bounds.high.x);
+    }
+    ASSERT_EQ(original.ibo.size(), index);
+    ASSERT_EQ(original.ibo, absoluteIndices(buffer));
+}
@@ -0,0 +1,240 @@
+//
+//  SimplifierTest.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "WavefrontFileReader.h"
+#include "WavefrontObject.hpp"
+#include "Simplifier.h"
+#include "VertexPacking.h"
+
+using namespace std;
+using namespace WavefrontFileReader;
+
+/**
+ * Flat grid of size x size quads split in triangles. Vertices with x above
+ * seam are duplicated with the texture coordinate 1 instead of 0, so the
+ * column at x = seam is a texture seam
+ */
+static VertexBuffer makeGrid(int size, int seam = -1)
+{
+    VertexBuffer buffer;
+
+    auto vertex = [&](int x, int y, int chart) -> uint32_t {
+        Vertex v;
+        v.position = fvec3(float(x), float(y), 0.0f);
+        v.normal = fvec3(0.0f, 0.0f, 1.0f);
+        v.texture = fvec3(float(chart), 0.0f, 0.0f);
+        for( uint32_t i = 0; i < buffer.vbo.size(); ++i )
+        {
+            if( buffer.vbo[i] == v )
+            {
+                return i;
+            }
+        }
+        buffer.vbo.push_back(v);
+        return uint32_t(buffer.vbo.size() - 1);
+    };
+
+    for( int y = 0; y < size; ++y )
+    {
+        for( int x = 0; x < size; ++x )
+        {
+            const int chart = (seam >= 0) && (x >= seam) ? 1 : 0;
+            const uint32_t a = vertex(x, y, chart), b = vertex(x + 1, y, chart);
+            const uint32_t c = vertex(x + 1, y + 1, chart), d = vertex(x, y + 1, chart);
+            buffer.ibo.insert(buffer.ibo.end(), { a, b, c, a, c, d });
+        }
+    }
+
+    Command command;
+    command.count = uint32_t(buffer.ibo.size());
+    buffer.commands.push_back(command);
+    return buffer;
+}
+
+/// Triangle area, signed by the z axis
+static float signedArea(const VertexBuffer& buffer, const Command& command, uint32_t i)
+{
+    const fvec3& a = buffer.vbo[buffer.index(i) + command.baseVertex].position;
+    const fvec3& b = buffer.vbo[buffer.index(i + 1) + command.baseVertex].position;
+    const fvec3& c = buffer.vbo[buffer.index(i + 2) + command.baseVertex].position;
+    return cross(b - a, c - a).z * 0.5f;
+}
+
+TEST(Simplifier, FlatGrid)
+{
+    VertexBuffer buffer = makeGrid(20);
+    const size_t fullIndices = buffer.ibo.size();
+
+    generateLods(buffer, { 0.1f, 0.5f });
+    ASSERT_EQ(2, buffer.lods.size());
+
+    // finer level first, the indices are added after the full detail
+    ASSERT_GT(buffer.lods[0].ratio, buffer.lods[1].ratio);
+    ASSERT_EQ(fullIndices, buffer.lods[0].commands[0].index);
+
+    for( const auto& lod : buffer.lods )
+    {
+        const Command& command = lod.commands[0];
+        ASSERT_LE(command.count / 3, fullIndices / 3 * (lod.ratio + 0.01f));
+
+        // a flat surface is simplified without error, keeps its border and
+        // has no flipped or overlapping triangles
+        float area = 0.0f;
+        for( uint32_t i = command.index; i < command.index + command.count; i += 3 )
+        {
+            const float triangleArea = signedArea(buffer, command, i);
+            ASSERT_GT(triangleArea, 0.0f);
+            area += triangleArea;
+        }
+        ASSERT_NEAR(400.0f, area, 1e-3f);
+        ASSERT_NEAR(0.0f, lod.error, 1e-3f);
+    }
+
+    ASSERT_NEAR(0.5f, buffer.lods[0].ratio, 0.01f);
+    ASSERT_LT(buffer.lods[1].ratio, 0.11f);
+}
+
+// triangles never use vertices from both sides of a seam
+TEST(Simplifier, Seams)
+{
+    VertexBuffer buffer = makeGrid(20, 7);
+    generateLods(buffer, { 0.2f });
+    ASSERT_EQ(1, buffer.lods.size());
+    ASSERT_LT(buffer.lods[0].ratio, 0.3f);
+
+    const Command& command = buffer.lods[0].commands[0];
+    float area = 0.0f;
+    for( uint32_t i = command.index; i < command.index + command.count; i += 3 )
+    {
+        const Vertex& a = buffer.vbo[buffer.ibo[i]];
+        const Vertex& b = buffer.vbo[buffer.ibo[i + 1]];
+        const Vertex& c = buffer.vbo[buffer.ibo[i + 2]];
+        ASSERT_EQ(a.texture.x, b.texture.x);
+        ASSERT_EQ(a.texture.x, c.texture.x);
+
+        // the seam doesn't move
+        const float limit = (a.texture.x == 0.0f) ? 7.0f : 20.0f;
+        ASSERT_LE(max(a.position.x, max(b.position.x, c.position.x)), limit);
+
+        area += signedArea(buffer, command, i);
+    }
+    ASSERT_NEAR(400.0f, area, 1e-3f);
+}
+
+TEST(Simplifier, Ducky)
+{
+    auto object = WavefrontFileReader::loadFile("ducky.obj");
+    const Object& wavefrontObject = *(Object*)(object.get());
+
+    VertexBuffer buffer = wavefrontObject.vertexBuffer();
+    const size_t fullIndices = buffer.ibo.size();
+    generateLods(buffer);
+    ASSERT_EQ(3, buffer.lods.size());
+
+    float previousError = 0.0f;
+    for( const auto& lod : buffer.lods )
+    {
+        ASSERT_EQ(buffer.commands.size(), lod.commands.size());
+
+        size_t indices = 0;
+        for( const auto& command : lod.commands )
+        {
+            ASSERT_GE(command.index, fullIndices);
+            ASSERT_LE(command.index + command.count, buffer.ibo.size());
+            indices += command.count;
+
+            for( uint32_t i = command.index; i < command.index + command.count; ++i )
+            {
+                ASSERT_LT(buffer.ibo[i], buffer.vbo.size());
+            }
+        }
+
+        ASSERT_FLOAT_EQ(float(indices) / fullIndices, lod.ratio);
+        ASSERT_GE(lod.error, previousError);
+        previousError = lod.error;
+    }
+
+    ASSERT_LT(buffer.lods[0].ratio, 0.55f);
+    ASSERT_LT(buffer.lods[2].ratio, 0.2f);
+
+    // the coarsest level stays close to the full detail
+    ASSERT_GT(buffer.lods[2].error, 0.0f);
+    ASSERT_LT(buffer.lods[2].error, buffer.scale * 0.05f);
+}
+
+TEST(Simplifier, SelectLod)
+{
+    VertexBuffer buffer;
+    buffer.lods.resize(3);
+    buffer.lods[0].error = 0.001f;
+    buffer.lods[1].error = 0.01f;
+    buffer.lods[2].error = 0.1f;
+
+    ASSERT_EQ(0, selectLod(buffer, 0.1f, 1000.0f));
+    ASSERT_EQ(1, selectLod(buffer, 1.0f, 1000.0f));
+    ASSERT_EQ(2, selectLod(buffer, 10.0f, 1000.0f));
+    ASSERT_EQ(3, selectLod(buffer, 100.0f, 1000.0f));
+    ASSERT_EQ(0, selectLod(VertexBuffer(), 100.0f, 1000.0f));
+}
+
+// the passes that change the indices keep the levels of detail
+TEST(Simplifier, Pipeline)
+{
+    auto object = WavefrontFileReader::loadFile("ducky.obj");
+    const Object& wavefrontObject = *(Object*)(object.get());
+
+    VertexBufferOptions options;
+    options.lodRatios = { 0.5f, 0.25f };
+    wavefrontObject.generateVertexBuffers(options);
+    const VertexBuffer reference = wavefrontObject.vertexBuffer();
+
+    options.optimizeVertexCache = true;
+    options.optimizeOverdraw = true;
+    options.optimizeVertexFetch = true;
+    options.shortIndices = true;
+    options.splitCommands = true;
+    wavefrontObject.generateVertexBuffers(options);
+    const VertexBuffer& buffer = wavefrontObject.vertexBuffer();
+    ASSERT_EQ(2, buffer.indexSize);
+    ASSERT_EQ(reference.lods.size(), buffer.lods.size());
+
+    // same positions drawn, the triangles may move
+    auto positions = [](const VertexBuffer& b, const vector<Command>& commands) {
+        vector<array<float, 9>> triangles;
+        for( const auto& command : commands )
+        {
+            for( uint32_t i = command.index; i + 2 < command.index + command.count; i += 3 )
+            {
+                array<float, 9> triangle;
+                for( uint32_t k = 0; k < 3; ++k )
+                {
+                    const fvec3& p = b.vbo[b.index(i + k) + command.baseVertex].position;
+                    triangle[3 * k] = p.x;
+                    triangle[3 * k + 1] = p.y;
+                    triangle[3 * k + 2] = p.z;
+                }
+                triangles.push_back(triangle);
+            }
+        }
+        sort(triangles.begin(), triangles.end());
+        return triangles;
+    };
+
+    for( size_t level = 0; level < buffer.lods.size(); ++level )
+    {
+        ASSERT_EQ(reference.lods[level].ratio, buffer.lods[level].ratio);
+        ASSERT_TRUE(positions(reference, reference.lods[level].commands) ==
+                    positions(buffer, buffer.lods[level].commands));
+    }
+}
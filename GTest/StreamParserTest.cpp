@@ -0,0 +1,157 @@
+//
+//  StreamParserTest.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "WavefrontFileReader.h"
+
+using namespace std;
+using namespace WavefrontFileReader;
+
+static std::string readFile(const std::string& fileName)
+{
+    ifstream file(fileName, ios::binary);
+    stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+static void expectSameObject(const IObject& a, const IObject& b)
+{
+    ASSERT_TRUE(a.vertices == b.vertices);
+    ASSERT_TRUE(a.texCoords == b.texCoords);
+    ASSERT_TRUE(a.normals == b.normals);
+    ASSERT_EQ(a.meshes.size(), b.meshes.size());
+    for( size_t i = 0; i < a.meshes.size(); ++i )
+    {
+        ASSERT_EQ(a.meshes[i].name, b.meshes[i].name);
+        ASSERT_EQ(a.meshes[i].numberOfElementsInFace, b.meshes[i].numberOfElementsInFace);
+        ASSERT_EQ(a.meshes[i].faces.indices(), b.meshes[i].faces.indices());
+        ASSERT_EQ(a.meshes[i].faces.offsets(), b.meshes[i].faces.offsets());
+    }
+    ASSERT_TRUE(a.bounds.low == b.bounds.low);
+    ASSERT_TRUE(a.bounds.high == b.bounds.high);
+}
+
+// the object built from a stream is the same as the one built from memory
+TEST(StreamParser, SameAsBuffer)
+{
+    const std::string content = readFile("ducky.obj");
+    auto expected = WavefrontFileReader::loadBuffer(content.data(), content.size());
+
+    stringstream stream(content);
+    auto object = WavefrontFileReader::loadFile(stream);
+    expectSameObject(*expected, *object);
+}
+
+// every element is handled once, in file order, whatever the batch size
+TEST(StreamParser, Batches)
+{
+    const std::string content = readFile("ducky.obj");
+    auto expected = WavefrontFileReader::loadBuffer(content.data(), content.size());
+
+    for( size_t batchSize : { size_t(1), size_t(7), size_t(1000000) } )
+    {
+        std::vector<fvec3> vertices, normals;
+        std::vector<std::string> groups;
+        size_t faces = 0, largestBatch = 0;
+
+        StreamHandlers handlers;
+        handlers.vertices = [&](ArrayView<fvec3> batch) {
+            largestBatch = std::max(largestBatch, batch.size());
+            vertices.insert(vertices.end(), batch.begin(), batch.end());
+        };
+        handlers.normals = [&](ArrayView<fvec3> batch) {
+            normals.insert(normals.end(), batch.begin(), batch.end());
+        };
+        handlers.faces = [&](const FaceList& batch) {
+            largestBatch = std::max(largestBatch, batch.size());
+
+            // faces only use the positions already handled
+            for( const auto& face : batch )
+            {
+                for( const auto& index : face.indices )
+                {
+                    ASSERT_LE(size_t(index.vertexIndex), vertices.size());
+                }
+            }
+            faces += batch.size();
+        };
+        handlers.group = [&](const std::string& name) { groups.push_back(name); };
+
+        stringstream stream(content);
+        ASSERT_EQ(content.size(), parseStream(stream, handlers, batchSize));
+        ASSERT_LE(largestBatch, batchSize);
+
+        ASSERT_TRUE(vertices == expected->vertices);
+        ASSERT_TRUE(normals == expected->normals);
+        ASSERT_EQ(expected->meshes.size(), groups.size());
+
+        size_t expectedFaces = 0;
+        for( size_t i = 0; i < groups.size(); ++i )
+        {
+            ASSERT_EQ(expected->meshes[i].name, groups[i]);
+            expectedFaces += expected->meshes[i].faces.size();
+        }
+        ASSERT_EQ(expectedFaces, faces);
+    }
+}
+
+// lines split between blocks and lines longer than a block
+TEST(StreamParser, LongLines)
+{
+    stringstream content;
+    content << "# " << std::string(600 * 1024, 'x') << "\n";
+    for( int i = 0; i < 50000; ++i )
+    {
+        content << "v " << i << " " << i * 0.5 << " " << -i << "\n";
+    }
+    content << "g a very long group name\n";
+    for( int i = 1; i + 2 <= 50000; i += 3 )
+    {
+        content << "f " << i << " " << i + 1 << " " << i + 2 << "\n";
+    }
+    content << "v 1 2 3";
+
+    const std::string text = content.str();
+    auto expected = WavefrontFileReader::loadBuffer(text.data(), text.size());
+    ASSERT_EQ(50001, expected->vertices.size());
+
+    stringstream stream(text);
+    auto object = WavefrontFileReader::loadFile(stream);
+    expectSameObject(*expected, *object);
+    ASSERT_EQ("a very long group name", object->meshes.back().name);
+}
+
+// a bounding box computed without keeping the object
+TEST(StreamParser, Bounds)
+{
+    auto expected = WavefrontFileReader::loadFile("ducky.obj");
+
+    Bounds bounds;
+    StreamHandlers handlers;
+    handlers.vertices = [&bounds](ArrayView<fvec3> vertices) {
+        for( const auto& vertex : vertices )
+        {
+            bounds.low = fvec3(std::min(bounds.low.x, vertex.x), std::min(bounds.low.y, vertex.y),
+                               std::min(bounds.low.z, vertex.z));
+            bounds.high = fvec3(std::max(bounds.high.x, vertex.x), std::max(bounds.high.y, vertex.y),
+                                std::max(bounds.high.z, vertex.z));
+        }
+    };
+
+    ifstream file("ducky.obj", ios::binary);
+    parseStream(file, handlers, 64);
+    ASSERT_TRUE(expected->bounds.low == bounds.low);
+    ASSERT_TRUE(expected->bounds.high == bounds.high);
+}
@@ -0,0 +1,240 @@
+//
+//  ThreadPoolTest.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include "ThreadPool.h"
+
+using namespace std;
+using namespace WavefrontFileReader;
+
+/// Wait until a counter reaches a value, false after a few seconds
+static bool waitFor(const atomic<int>& counter, int value)
+{
+    const auto deadline = chrono::steady_clock::now() + chrono::seconds(5);
+    while( counter < value )
+    {
+        if( chrono::steady_clock::now() > deadline )
+        {
+            return false;
+        }
+        this_thread::yield();
+    }
+    return true;
+}
+
+TEST(ThreadPool, ParallelFor)
+{
+    ThreadPoolOptions options;
+    options.threadCount = 4;
+    ThreadPool pool(options);
+    ASSERT_EQ(4, pool.threadCount());
+
+    for( unsigned maxThreads : { 0u, 1u, 3u, 16u } )
+    {
+        vector<atomic<int>> calls(1000);
+        for( auto& call : calls )
+        {
+            call = 0;
+        }
+
+        pool.parallelFor(calls.size(), [&calls](size_t i) { ++calls[i]; }, maxThreads);
+        for( const auto& call : calls )
+        {
+            ASSERT_EQ(1, call);
+        }
+    }
+
+    pool.parallelFor(0, [](size_t) { FAIL(); });
+}
+
+// tasks queued by a worker are taken by the idle workers
+TEST(ThreadPool, Stealing)
+{
+    ThreadPoolOptions options;
+    options.threadCount = 4;
+    ThreadPool pool(options);
+
+    atomic<int> started(0);
+    atomic<bool> done(false);
+    mutex threadsMutex;
+    set<thread::id> threads;
+
+    pool.submit([&]() {
+        // the tasks go to the queue of this worker, which stays busy
+        for( int i = 0; i < 3; ++i )
+        {
+            pool.submit([&]() {
+                {
+                    lock_guard<mutex> lock(threadsMutex);
+                    threads.insert(this_thread::get_id());
+                }
+                ++started;
+                waitFor(started, 3);
+            });
+        }
+        waitFor(started, 3);
+        done = true;
+    });
+
+    const auto deadline = chrono::steady_clock::now() + chrono::seconds(10);
+    while( !done && (chrono::steady_clock::now() < deadline) )
+    {
+        this_thread::yield();
+    }
+    ASSERT_TRUE(done);
+    ASSERT_EQ(3, started);
+    ASSERT_EQ(3, threads.size());
+}
+
+// a worker waiting for a group runs its tasks, nested groups don't block
+TEST(ThreadPool, Nested)
+{
+    ThreadPoolOptions options;
+    options.threadCount = 1;
+    ThreadPool pool(options);
+
+    atomic<int> leaves(0);
+    function<void(int)> split = [&](int depth) {
+        if( depth == 0 )
+        {
+            ++leaves;
+            return;
+        }
+        TaskGroup group(pool);
+        group.run([&split, depth]() { split(depth - 1); });
+        group.run([&split, depth]() { split(depth - 1); });
+        group.wait();
+    };
+
+    TaskGroup group(pool);
+    group.run([&split]() { split(8); });
+    group.wait();
+    ASSERT_EQ(256, leaves);
+
+    // a parallel loop inside the tasks of another one
+    atomic<int> calls(0);
+    pool.parallelFor(8, [&](size_t) {
+        pool.parallelFor(8, [&calls](size_t) { ++calls; });
+    });
+    ASSERT_EQ(64, calls);
+}
+
+TEST(ThreadPool, Exceptions)
+{
+    ThreadPoolOptions options;
+    options.threadCount = 2;
+    ThreadPool pool(options);
+
+    TaskGroup group(pool);
+    atomic<int> calls(0);
+    for( int i = 0; i < 10; ++i )
+    {
+        group.run([&calls, i]() {
+            ++calls;
+            if( i == 5 )
+            {
+                throw runtime_error("task");
+            }
+        });
+    }
+    ASSERT_THROW(group.wait(), runtime_error);
+    ASSERT_EQ(10, calls);
+
+    // the group can be used again
+    group.run([&calls]() { ++calls; });
+    ASSERT_NO_THROW(group.wait());
+
+    ASSERT_THROW(pool.parallelFor(100, [](size_t i) {
+        if( i == 50 )
+        {
+            throw runtime_error("index");
+        }
+    }), runtime_error);
+
+    // the pool still runs tasks
+    pool.submit([]() { throw runtime_error("lost"); });
+    pool.parallelFor(4, [&calls](size_t) { ++calls; });
+    ASSERT_EQ(15, calls);
+}
+
+// the queued tasks are run before the workers stop
+TEST(ThreadPool, Destructor)
+{
+    atomic<int> calls(0);
+    {
+        ThreadPoolOptions options;
+        options.threadCount = 2;
+        ThreadPool pool(options);
+        for( int i = 0; i < 100; ++i )
+        {
+            pool.submit([&calls]() {
+                this_thread::sleep_for(chrono::microseconds(100));
+                ++calls;
+            });
+        }
+    }
+    ASSERT_EQ(100, calls);
+}
+
+#if defined(__linux__)
+TEST(ThreadPool, Affinity)
+{
+    // the first processor the tests may use
+    cpu_set_t allowed;
+    ASSERT_EQ(0, sched_getaffinity(0, sizeof(allowed), &allowed));
+    int cpu = 0;
+    while( !CPU_ISSET(cpu, &allowed) )
+    {
+        ++cpu;
+    }
+
+    ThreadPoolOptions options;
+    options.threadCount = 2;
+    options.cpus = { unsigned(cpu) };
+    ThreadPool pool(options);
+
+    atomic<int> pinned(0), calls(0);
+    for( int i = 0; i < 16; ++i )
+    {
+        pool.submit([&pinned, &calls, cpu]() {
+            pinned += (sched_getcpu() == cpu) ? 1 : 0;
+            ++calls;
+        });
+    }
+    ASSERT_TRUE(waitFor(calls, 16));
+    ASSERT_EQ(16, pinned);
+
+    options.cpus = { 100000 };
+    ASSERT_THROW(ThreadPool invalid(options), runtime_error);
+}
+#endif
+
+// the shared pool is started again with new options
+TEST(ThreadPool, Shared)
+{
+    ThreadPoolOptions options;
+    options.threadCount = 3;
+    ThreadPool::configureShared(options);
+    ASSERT_EQ(3, ThreadPool::shared().threadCount());
+
+    ThreadPool::configureShared(ThreadPoolOptions());
+    ASSERT_EQ(max(1u, thread::hardware_concurrency()), ThreadPool::shared().threadCount());
+}
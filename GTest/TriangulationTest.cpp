@@ -0,0 +1,129 @@
+//
+//  TriangulationTest.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include <algorithm>
+#include <array>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "WavefrontFileReader.h"
+#include "WavefrontObject.hpp"
+#include "Simplifier.h"
+#include "Triangulation.h"
+
+using namespace std;
+using namespace WavefrontFileReader;
+
+/// Triangles drawn by the commands, sorted, as vertex numbers
+static vector<array<uint32_t, 3>> drawnTriangles(const VertexBuffer& buffer,
+                                                 const vector<Command>& commands)
+{
+    vector<array<uint32_t, 3>> triangles;
+    for( const auto& command : commands )
+    {
+        EXPECT_EQ(Command::Triangles, command.type);
+        for( uint32_t i = command.index; i + 2 < command.index + command.count; i += 3 )
+        {
+            triangles.push_back({ buffer.index(i) + command.baseVertex,
+                                  buffer.index(i + 1) + command.baseVertex,
+                                  buffer.index(i + 2) + command.baseVertex });
+        }
+    }
+    sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+// quad meshes are drawn like the meshes split at load time
+TEST(Triangulation, HumanoidQuad)
+{
+    auto object = WavefrontFileReader::loadFile("humanoid_quad.obj");
+    const Object& wavefrontObject = *(Object*)(object.get());
+
+    wavefrontObject.generateVertexBuffers(true);
+    const VertexBuffer triangles = wavefrontObject.vertexBuffer();
+
+    wavefrontObject.generateVertexBuffers(false);
+    VertexBuffer quads = wavefrontObject.vertexBuffer();
+    ASSERT_TRUE(any_of(quads.commands.begin(), quads.commands.end(), [](const Command& command) {
+        return command.type == Command::Quads;
+    }));
+    ASSERT_LT(quads.ibo.size(), triangles.ibo.size());
+
+    triangulateQuads(quads);
+
+    ASSERT_TRUE(triangles.vbo == quads.vbo);
+    ASSERT_EQ(drawnTriangles(triangles, triangles.commands),
+              drawnTriangles(quads, quads.commands));
+}
+
+// faces that are not quads are always split in triangles
+TEST(Triangulation, MixedFaces)
+{
+    stringstream stream;
+    stream << "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nv 2 0 0\nv 2 1 0\nv 3 0 0\n"
+           << "f 1 2 3\n"
+           << "f 2 5 6 3\n"
+           << "f 5 7 6 4 1\n";
+
+    auto object = WavefrontFileReader::loadFile(stream);
+    const Object& wavefrontObject = *(Object*)(object.get());
+
+    wavefrontObject.generateVertexBuffers(false);
+    VertexBuffer buffer = wavefrontObject.vertexBuffer();
+
+    ASSERT_EQ(2, buffer.commands.size());
+    ASSERT_EQ(Command::Quads, buffer.commands[0].type);
+    ASSERT_EQ(4, buffer.commands[0].count);
+    ASSERT_EQ(Command::Triangles, buffer.commands[1].type);
+    ASSERT_EQ(3 + 9, buffer.commands[1].count);
+
+    triangulateQuads(buffer);
+    ASSERT_EQ(18, buffer.ibo.size());
+
+    wavefrontObject.generateVertexBuffers(true);
+    const VertexBuffer& triangles = wavefrontObject.vertexBuffer();
+    ASSERT_EQ(drawnTriangles(triangles, triangles.commands),
+              drawnTriangles(buffer, buffer.commands));
+}
+
+// the levels of detail keep pointing to the quads they share
+TEST(Triangulation, LevelsOfDetail)
+{
+    stringstream stream;
+    stream << "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nv 2 0 0\nv 2 1 0\n"
+           << "g quads\n"
+           << "f 1 2 3 4\n"
+           << "f 2 5 6 3\n"
+           << "g triangles\n"
+           << "f 1 2 3\n"
+           << "f 1 3 4\n";
+
+    auto object = WavefrontFileReader::loadFile(stream);
+    const Object& wavefrontObject = *(Object*)(object.get());
+
+    wavefrontObject.generateVertexBuffers(false);
+    VertexBuffer buffer = wavefrontObject.vertexBuffer();
+    generateLods(buffer, { 0.5f });
+    ASSERT_EQ(1, buffer.lods.size());
+
+    const auto quads = buffer.commands[0];
+    ASSERT_EQ(Command::Quads, quads.type);
+
+    triangulateQuads(buffer);
+
+    ASSERT_EQ(buffer.commands[0], buffer.lods[0].commands[0]);
+    ASSERT_EQ(12, buffer.commands[0].count);
+    ASSERT_EQ(buffer.commands[0].index + 12, buffer.commands[1].index);
+
+    // the simplified triangles follow the full detail
+    ASSERT_EQ(buffer.commands[1].index + buffer.commands[1].count,
+              buffer.lods[0].commands[1].index);
+    ASSERT_EQ(buffer.ibo.size(),
+              buffer.lods[0].commands[1].index + buffer.lods[0].commands[1].count);
+}
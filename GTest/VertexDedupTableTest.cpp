@@ -0,0 +1,67 @@
+//
+//  VertexDedupTableTest.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include <gtest/gtest.h>
+
+#include "VertexDedupTable.h"
+
+using namespace std;
+using namespace WavefrontFileReader;
+
+static IndexData makeIndex(int vertex, int texture, int normal)
+{
+    IndexData index;
+    index.vertexIndex = vertex;
+    index.textureIndex = texture;
+    index.normalIndex = normal;
+    return index;
+}
+
+// permutations of the same indices are different keys
+TEST(VertexDedupTable, Permutations)
+{
+    VertexDedupTable table;
+    bool inserted = false;
+
+    ASSERT_EQ(0, table.insert(makeIndex(1, 2, 3), 0, inserted));
+    ASSERT_TRUE(inserted);
+    ASSERT_EQ(1, table.insert(makeIndex(3, 2, 1), 1, inserted));
+    ASSERT_TRUE(inserted);
+    ASSERT_EQ(2, table.insert(makeIndex(2, 3, 1), 2, inserted));
+    ASSERT_TRUE(inserted);
+
+    ASSERT_EQ(0, table.insert(makeIndex(1, 2, 3), 7, inserted));
+    ASSERT_FALSE(inserted);
+    ASSERT_EQ(1, table.insert(makeIndex(3, 2, 1), 7, inserted));
+    ASSERT_FALSE(inserted);
+    ASSERT_EQ(3, table.size());
+
+    ASSERT_NE(VertexDedupTable::hash(makeIndex(1, 2, 3)),
+              VertexDedupTable::hash(makeIndex(3, 2, 1)));
+}
+
+// the table grows past the expected size and keeps all the values
+TEST(VertexDedupTable, Grow)
+{
+    VertexDedupTable table(4);
+    bool inserted = false;
+
+    for( int i = 0; i < 10000; ++i )
+    {
+        table.insert(makeIndex(i + 1, i % 7, i % 3), uint32_t(i), inserted);
+        ASSERT_TRUE(inserted);
+    }
+
+    ASSERT_EQ(10000, table.size());
+
+    for( int i = 0; i < 10000; ++i )
+    {
+        ASSERT_EQ(uint32_t(i), table.insert(makeIndex(i + 1, i % 7, i % 3), 0, inserted));
+        ASSERT_FALSE(inserted);
+    }
+}
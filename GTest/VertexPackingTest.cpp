@@ -0,0 +1,114 @@
+//
+//  VertexPackingTest.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "WavefrontFileReader.h"
+#include "WavefrontObject.hpp"
+#include "VertexPacking.h"
+
+using namespace std;
+using namespace WavefrontFileReader;
+
+static float distance(const fvec3& a, const fvec3& b)
+{
+    return sqrt((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y) +
+                (a.z - b.z) * (a.z - b.z));
+}
+
+static float length(const fvec3& a)
+{
+    return distance(a, fvec3());
+}
+
+TEST(VertexPacking, HalfFloat)
+{
+    for( float value : { 0.0f, 1.0f, -2.5f, 0.333333f, 65504.0f, 6.1035156e-05f,
+                         5.9604645e-08f, 1000.1f } )
+    {
+        const float result = halfToFloat(floatToHalf(value));
+        ASSERT_NEAR(value, result, fabs(value) / 1024.0f) << value;
+    }
+
+    ASSERT_EQ(0x3C00, floatToHalf(1.0f));
+    ASSERT_EQ(0xC000, floatToHalf(-2.0f));
+    ASSERT_EQ(0x7BFF, floatToHalf(65504.0f));
+    ASSERT_EQ(0x7C00, floatToHalf(1e10f));
+    ASSERT_EQ(0x0001, floatToHalf(5.9604645e-08f));
+
+    // halfway between 1 and the next half rounds to even
+    ASSERT_EQ(0x3C00, floatToHalf(1.0f + 1.0f / 2048.0f));
+    ASSERT_EQ(0x3C02, floatToHalf(1.0f + 3.0f / 2048.0f));
+}
+
+TEST(VertexPacking, Octahedral)
+{
+    const fvec3 normals[] = {
+        fvec3(0, 0, 1), fvec3(0, 0, -1), fvec3(1, 0, 0), fvec3(0, -1, 0),
+        fvec3(0.3f, -0.5f, -0.8f), fvec3(-0.6f, 0.7f, 0.2f), fvec3(-1, -1, -1)
+    };
+
+    for( const auto& normal : normals )
+    {
+        int16_t x = 0, y = 0;
+        encodeOctahedral(normal, x, y);
+        const fvec3 result = decodeOctahedral(x, y);
+
+        const float scale = 1.0f / length(normal);
+        const fvec3 expected(normal.x * scale, normal.y * scale, normal.z * scale);
+        ASSERT_LT(distance(expected, result), 1e-4f);
+    }
+}
+
+TEST(VertexPacking, Ducky)
+{
+    auto object = WavefrontFileReader::loadFile("ducky.obj");
+    const Object& wavefrontObject = *(Object*)(object.get());
+    const VertexBuffer original = wavefrontObject.vertexBuffer();
+
+    // largest position extent, the precision is relative to it
+    float extent = 0;
+    for( const auto& vertex : original.vbo )
+    {
+        extent = max(extent, length(vertex.position));
+    }
+
+    for( auto format : { VertexLayout::Normalized16, VertexLayout::HalfFloat } )
+    {
+        VertexBufferOptions options;
+        options.vertexFormat = format;
+        wavefrontObject.generateVertexBuffers(options);
+        const VertexBuffer& buffer = wavefrontObject.vertexBuffer();
+
+        ASSERT_TRUE(buffer.vbo.empty());
+        ASSERT_EQ(format, buffer.layout.format);
+        ASSERT_EQ(16, buffer.layout.stride);
+        ASSERT_EQ(original.vbo.size(), buffer.verticesCount());
+        ASSERT_EQ(original.ibo, buffer.ibo);
+
+        const auto vertices = unpackVertices(buffer);
+        ASSERT_EQ(original.vbo.size(), vertices.size());
+        for( size_t i = 0; i < vertices.size(); ++i )
+        {
+            const Vertex& expected = original.vbo[i];
+            ASSERT_LT(distance(expected.position, vertices[i].position), extent / 1000.0f);
+            ASSERT_NEAR(expected.texture.x, vertices[i].texture.x, 1e-3f);
+            ASSERT_NEAR(expected.texture.y, vertices[i].texture.y, 1e-3f);
+
+            if( length(expected.normal) > 0 )
+            {
+                const float scale = 1.0f / length(expected.normal);
+                const fvec3 normal(expected.normal.x * scale, expected.normal.y * scale,
+                                   expected.normal.z * scale);
+                ASSERT_LT(distance(normal, vertices[i].normal), 1e-3f);
+            }
+        }
+    }
+}
@@ -0,0 +1,147 @@
+//
+//  VertexWelderTest.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "WavefrontFileReader.h"
+#include "WavefrontObject.hpp"
+#include "VertexWelder.h"
+
+using namespace std;
+using namespace WavefrontFileReader;
+
+static IndexData makeIndex(int vertex, int texture, int normal)
+{
+    IndexData index;
+    index.vertexIndex = vertex;
+    index.textureIndex = texture;
+    index.normalIndex = normal;
+    return index;
+}
+
+static CornerSegments makeSegments(const vector<IndexData>& corners, size_t segmentSize)
+{
+    CornerSegments segments;
+    for( size_t i = 0; i < corners.size(); i += segmentSize )
+    {
+        const size_t end = std::min(corners.size(), i + segmentSize);
+        segments.push_back(ArrayView<IndexData>(corners.data() + i, corners.data() + end));
+    }
+    return segments;
+}
+
+static void expectSameWelding(const vector<IndexData>& corners, size_t segmentSize)
+{
+    const auto segments = makeSegments(corners, segmentSize);
+
+    WeldResult hash, sort;
+    weldWithHash(segments, 0, hash);
+    weldWithSort(segments, sort);
+
+    ASSERT_EQ(corners.size(), sort.vertexOfCorner.size());
+    ASSERT_EQ(hash.vertexOfCorner, sort.vertexOfCorner);
+    ASSERT_EQ(hash.vertices.size(), sort.vertices.size());
+    for( size_t i = 0; i < hash.vertices.size(); ++i )
+    {
+        ASSERT_EQ(hash.vertices[i], sort.vertices[i]);
+    }
+
+    // every corner uses a vertex with its indices
+    for( size_t i = 0; i < corners.size(); ++i )
+    {
+        ASSERT_EQ(corners[i], sort.vertices[sort.vertexOfCorner[i]]);
+    }
+}
+
+TEST(VertexWelder, Empty)
+{
+    WeldResult result;
+    weldWithSort(CornerSegments(), result);
+
+    ASSERT_TRUE(result.vertexOfCorner.empty());
+    ASSERT_TRUE(result.vertices.empty());
+}
+
+// vertices are numbered in the order of their first corner
+TEST(VertexWelder, FirstSeenOrder)
+{
+    const vector<IndexData> corners = {
+        makeIndex(5, 1, 1), makeIndex(2, 1, 1), makeIndex(5, 1, 1),
+        makeIndex(1, 2, 3), makeIndex(3, 2, 1), makeIndex(2, 1, 1)
+    };
+
+    WeldResult result;
+    weldWithSort(makeSegments(corners, 4), result);
+
+    const vector<uint32_t> expected = { 0, 1, 0, 2, 3, 1 };
+    ASSERT_EQ(expected, result.vertexOfCorner);
+    ASSERT_EQ(4, result.vertices.size());
+    ASSERT_EQ(makeIndex(5, 1, 1), result.vertices[0]);
+    ASSERT_EQ(makeIndex(3, 2, 1), result.vertices[3]);
+}
+
+// small indices use a 64 bits key, large and negative indices a 96 bits key
+TEST(VertexWelder, SameAsHash)
+{
+    std::mt19937 generator(7);
+
+    for( int range : { 16, 5000, 1 << 30 } )
+    {
+        std::uniform_int_distribution<int> distribution(1, range);
+        std::uniform_int_distribution<int> pick(0, 99);
+
+        vector<IndexData> corners;
+        for( int i = 0; i < 20000; ++i )
+        {
+            // reuse older corners so there are many duplicates
+            if( !corners.empty() && (pick(generator) < 50) )
+            {
+                corners.push_back(corners[corners.size() * pick(generator) / 100]);
+                continue;
+            }
+
+            corners.push_back(makeIndex(distribution(generator), distribution(generator),
+                                        (range > 5000) ? -distribution(generator)
+                                                       : distribution(generator)));
+        }
+
+        expectSameWelding(corners, 3000);
+    }
+}
+
+// both methods build the same vertex buffer
+TEST(VertexWelder, SameVertexBuffer)
+{
+    for( const char* fileName : { "cube.obj", "ducky.obj", "humanoid_quad.obj" } )
+    {
+        auto object = WavefrontFileReader::loadFile(fileName);
+        const Object& wavefrontObject = *(Object*)(object.get());
+
+        for( bool splitInTriangles : { true, false } )
+        {
+            VertexBufferOptions options;
+            options.splitInTriangles = splitInTriangles;
+
+            options.welding = VertexBufferOptions::Hash;
+            wavefrontObject.generateVertexBuffers(options);
+            const VertexBuffer hash = wavefrontObject.vertexBuffer();
+
+            options.welding = VertexBufferOptions::Sort;
+            wavefrontObject.generateVertexBuffers(options);
+            const VertexBuffer& sort = wavefrontObject.vertexBuffer();
+
+            ASSERT_FALSE(sort.empty());
+            ASSERT_TRUE(hash.vbo == sort.vbo);
+            ASSERT_EQ(hash.ibo, sort.ibo);
+            ASSERT_EQ(hash.commands, sort.commands);
+            ASSERT_EQ(hash.scale, sort.scale);
+        }
+    }
+}
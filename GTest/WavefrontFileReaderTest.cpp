@@ -9,6 +9,7 @@
 #include <gtest/gtest.h>
 
 #include <sstream>
+#include <fstream>
 
 #include "WavefrontFileReader.h"
 
@@ -310,3 +311,128 @@ TEST(WavefrontFileReader, Quad)
     }
 }
 
+
+// compare all the elements read from file
+static void compareObjects(const IObject& a, const IObject& b)
+{
+    ASSERT_TRUE(a.vertices == b.vertices);
+    ASSERT_TRUE(a.texCoords == b.texCoords);
+    ASSERT_TRUE(a.normals == b.normals);
+    ASSERT_EQ(a.meshes.size(), b.meshes.size());
+
+    for( size_t i = 0; i < a.meshes.size(); ++i )
+    {
+        const auto& meshA = a.meshes[i];
+        const auto& meshB = b.meshes[i];
+
+        ASSERT_TRUE(meshA.name == meshB.name);
+        ASSERT_EQ(meshA.numberOfElementsInFace, meshB.numberOfElementsInFace);
+        ASSERT_EQ(meshA.faces.size(), meshB.faces.size());
+
+        for( size_t j = 0; j < meshA.faces.size(); ++j )
+        {
+            ASSERT_TRUE(meshA.faces[j].indices == meshB.faces[j].indices);
+        }
+    }
+}
+
+// memory mapped file gives the same result as the stream parser
+TEST(WavefrontFileReader, MappedFile)
+{
+    try
+    {
+        for( auto fileName : { "cube.obj", "ducky.obj", "humanoid_quad.obj" } )
+        {
+            ifstream file(fileName);
+            ASSERT_TRUE(file.is_open());
+
+            auto streamObject = WavefrontFileReader::loadFile(file);
+            auto mappedObject = WavefrontFileReader::loadMappedFile(fileName);
+
+            ASSERT_FALSE(mappedObject->empty());
+            compareObjects(*streamObject, *mappedObject);
+        }
+    }
+    catch (std::exception& ex)
+    {
+        ASSERT_TRUE(false);
+    }
+}
+
+// buffer that is not null terminated and has comments after the data
+TEST(WavefrontFileReader, Buffer)
+{
+    const std::string content = "v 1 2 3 # comment\r\n"
+                                "vt 0.5 0.25\r\n"
+                                "g first   group\n"
+                                "f 1/1 1/1 1/1 # 4/4";
+
+    // copy without the terminator so the parser can't read past the end
+    std::vector<char> buffer(content.begin(), content.end());
+
+    auto object = WavefrontFileReader::loadBuffer(buffer.data(), buffer.size());
+
+    ASSERT_EQ(1, object->vertices.size());
+    ASSERT_EQ(3.0f, object->vertices[0].z);
+    ASSERT_EQ(1, object->texCoords.size());
+    ASSERT_EQ(0.25f, object->texCoords[0].y);
+    ASSERT_EQ(1, object->meshes.size());
+    ASSERT_TRUE(object->meshes[0].name == "first group");
+    ASSERT_EQ(1, object->meshes[0].faces.size());
+    ASSERT_EQ(3, object->meshes[0].numberOfElementsInFace);
+    ASSERT_EQ(1, object->meshes[0].faces[0].indices[2].textureIndex);
+}
+
+// parallel parser gives the same result as the serial one
+TEST(WavefrontFileReader, ParallelDucky)
+{
+    try
+    {
+        auto serialObject = WavefrontFileReader::loadFile("ducky.obj");
+
+        for( unsigned threads : { 1, 2, 3, 7, 16 } )
+        {
+            auto parallelObject = WavefrontFileReader::loadFileParallel("ducky.obj", threads);
+            compareObjects(*serialObject, *parallelObject);
+        }
+    }
+    catch (std::exception& ex)
+    {
+        ASSERT_TRUE(false);
+    }
+}
+
+// groups and faces that continue a group are split between chunks
+TEST(WavefrontFileReader, ParallelChunkBoundaries)
+{
+    stringstream stream;
+    for( int i = 1; i <= 20000; ++i )
+    {
+        stream << "v " << i << " 0.5 -1.25e-1\n";
+        if( i > 2 )
+        {
+            stream << "f " << i-2 << " " << i-1 << " " << i << "\n";
+        }
+        if( (i % 997) == 0 )
+        {
+            // some groups have no faces at all
+            stream << "g group " << i << "\n";
+        }
+        if( (i % 1999) == 0 )
+        {
+            stream << "f " << i-2 << " " << i-1 << " " << i << " " << i << "\n";
+        }
+    }
+    const std::string content = stream.str();
+
+    auto serialObject = WavefrontFileReader::loadBuffer(content.data(), content.size());
+    ASSERT_EQ(21, serialObject->meshes.size());
+
+    for( unsigned threads : { 2, 5, 9 } )
+    {
+        auto parallelObject = WavefrontFileReader::loadBufferParallel(content.data(),
+                                                                      content.size(),
+                                                                      threads);
+        compareObjects(*serialObject, *parallelObject);
+    }
+}
@@ -7,10 +7,13 @@
 //
 
 #include <stdio.h>
+#include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 #include "WavefrontFileReader.h"
+#include "WavefrontObject.hpp"
 
 using namespace std;
 using namespace WavefrontFileReader;
@@ -67,6 +70,138 @@ TEST_F(RendererTest, Ducky)
     ASSERT_EQ(8850, m_object.vbo.size() );
 }
 
+// Meshes built on worker threads draw the same triangles, the buffer doesn't
+// depend on the number of threads
+TEST(VertexBufferTest, ParallelMeshes)
+{
+    for( const char* fileName : { "ducky.obj", "humanoid_quad.obj" } )
+    {
+        auto object = WavefrontFileReader::loadFile(fileName);
+        const Object& wavefrontObject = *(Object*)(object.get());
+
+        const VertexBuffer serial = wavefrontObject.vertexBuffer();
+
+        VertexBufferOptions options;
+        options.parallel = true;
+        options.threadCount = 1;
+        wavefrontObject.generateVertexBuffers(options);
+        const VertexBuffer parallel = wavefrontObject.vertexBuffer();
+
+        ASSERT_EQ(serial.ibo.size(), parallel.ibo.size());
+        ASSERT_EQ(serial.commands, parallel.commands);
+        ASSERT_EQ(serial.scale, parallel.scale);
+        for( size_t i = 0; i < serial.ibo.size(); ++i )
+        {
+            ASSERT_EQ(serial.vbo[serial.ibo[i]], parallel.vbo[parallel.ibo[i]]);
+        }
+
+        for( unsigned threadCount : { 2, 4, 16 } )
+        {
+            options.threadCount = threadCount;
+            wavefrontObject.generateVertexBuffers(options);
+            const VertexBuffer& buffer = wavefrontObject.vertexBuffer();
+
+            ASSERT_TRUE(buffer.vbo == parallel.vbo);
+            ASSERT_EQ(parallel.ibo, buffer.ibo);
+            ASSERT_EQ(parallel.commands, buffer.commands);
+        }
+    }
+}
+
+// Threads asking for the same options share a single build
+TEST(VertexBufferTest, ConcurrentOptions)
+{
+    auto object = WavefrontFileReader::loadFile("humanoid_quad.obj");
+    const Object& wavefrontObject = *(Object*)(object.get());
+
+    VertexBufferOptions options;
+    options.shortIndices = true;
+    options.vertexFormat = VertexLayout::Normalized16;
+
+    auto reference = WavefrontFileReader::loadFile("humanoid_quad.obj");
+    (*(Object*)(reference.get())).generateVertexBuffers(options);
+    const VertexBuffer& expected = reference->vertexBuffer();
+
+    vector<const VertexBuffer*> buffers(8, nullptr);
+    vector<thread> threads;
+    for( size_t i = 0; i < buffers.size(); ++i )
+    {
+        threads.emplace_back([&wavefrontObject, &options, &buffers, i]() {
+            buffers[i] = &wavefrontObject.vertexBuffer(options);
+        });
+    }
+    for( auto& thread : threads )
+    {
+        thread.join();
+    }
+
+    for( const VertexBuffer* buffer : buffers )
+    {
+        ASSERT_EQ(buffers.front(), buffer);
+    }
+    ASSERT_TRUE(expected.packedVbo == buffers.front()->packedVbo);
+    ASSERT_EQ(expected.ibo16, buffers.front()->ibo16);
+    ASSERT_EQ(expected.commands, buffers.front()->commands);
+
+    // other options are built in a buffer of their own
+    VertexBufferOptions quads;
+    quads.splitInTriangles = false;
+    const VertexBuffer& quadsBuffer = wavefrontObject.vertexBuffer(quads);
+    ASSERT_NE(buffers.front(), &quadsBuffer);
+    ASSERT_NE(expected.commands, quadsBuffer.commands);
+    ASSERT_EQ(&quadsBuffer, &wavefrontObject.vertexBuffer(quads));
+
+    // the lazy buffer isn't built with the options
+    ASSERT_TRUE(wavefrontObject.m_vertexBuffer.empty());
+}
+
+// The generated buffer is returned when the options match
+TEST(VertexBufferTest, GeneratedBuffer)
+{
+    auto object = WavefrontFileReader::loadFile("ducky.obj");
+    const Object& wavefrontObject = *(Object*)(object.get());
+
+    VertexBufferOptions options;
+    options.meshlets = true;
+    wavefrontObject.generateVertexBuffers(options);
+    ASSERT_EQ(&wavefrontObject.m_vertexBuffer, &wavefrontObject.vertexBuffer(options));
+
+    // the threads only change how the buffer is built
+    options.parallel = true;
+    options.threadCount = 2;
+    ASSERT_EQ(&wavefrontObject.m_vertexBuffer, &wavefrontObject.vertexBuffer(options));
+
+    options.meshlets = false;
+    ASSERT_NE(&wavefrontObject.m_vertexBuffer, &wavefrontObject.vertexBuffer(options));
+}
+
+// The default buffer is built once when many threads ask for it
+TEST(VertexBufferTest, ConcurrentDefault)
+{
+    auto object = WavefrontFileReader::loadFile("ducky.obj");
+    const VertexBuffer expected = WavefrontFileReader::loadFile("ducky.obj")->vertexBuffer();
+
+    vector<const VertexBuffer*> buffers(8, nullptr);
+    vector<thread> threads;
+    for( size_t i = 0; i < buffers.size(); ++i )
+    {
+        threads.emplace_back([&object, &buffers, i]() {
+            buffers[i] = &object->vertexBuffer();
+        });
+    }
+    for( auto& thread : threads )
+    {
+        thread.join();
+    }
+
+    for( const VertexBuffer* buffer : buffers )
+    {
+        ASSERT_EQ(buffers.front(), buffer);
+    }
+    ASSERT_TRUE(expected.vbo == buffers.front()->vbo);
+    ASSERT_EQ(expected.ibo, buffers.front()->ibo);
+}
+
 // Same shape is saved as triangles and quads. Check if triagulation works
 //TEST(WavefrontRendererTest, SameFileDifferentRepresentation)
 //{
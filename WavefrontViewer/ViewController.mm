@@ -11,6 +11,7 @@
 #import <OpenGLES/ES2/glext.h>
 
 #include "WavefrontFileReader.h"
+#include "AsyncLoader.h"
 #include "WavefrontRenderer.h"
 
 using namespace std;
@@ -19,6 +20,9 @@ using namespace std;
 enum {
     UNIFORM_MODELVIEWPROJECTION_MATRIX,
     UNIFORM_NORMAL_MATRIX,
+    UNIFORM_POSITION_OFFSET,
+    UNIFORM_POSITION_SCALE,
+    UNIFORM_OCTAHEDRAL_NORMALS,
     NUM_UNIFORMS
 };
 GLint uniforms[NUM_UNIFORMS];
@@ -31,6 +35,7 @@ GLint uniforms[NUM_UNIFORMS];
     float _rotation;
 
     std::unique_ptr<WavefrontRenderer> _render;
+    WavefrontFileReader::LoadHandle _loading;
 
     int _renderFileIndex;
 }
@@ -113,6 +118,8 @@ GLint uniforms[NUM_UNIFORMS];
 #pragma mark - GLKView and GLKViewController delegate methods
 
 - (void)update {
+    [self finishLoading];
+
     float aspect = fabs(self.view.bounds.size.width / self.view.bounds.size.height);
     GLKMatrix4 projectionMatrix = GLKMatrix4MakePerspective(GLKMathDegreesToRadians(65.0f), aspect, 0.1f, 100.0f);
 
@@ -162,8 +169,22 @@ GLint uniforms[NUM_UNIFORMS];
 
     // TODO: render objects
     if ( _render) {
-        
-        _render->draw();
+        const VertexLayout& layout = _render->vertexLayout();
+        glUniform3f(uniforms[UNIFORM_POSITION_OFFSET], layout.positionOffset.x,
+                    layout.positionOffset.y, layout.positionOffset.z);
+        glUniform3f(uniforms[UNIFORM_POSITION_SCALE], layout.positionScale.x,
+                    layout.positionScale.y, layout.positionScale.z);
+        glUniform1i(uniforms[UNIFORM_OCTAHEDRAL_NORMALS], layout.octahedralNormals);
+
+        // the object is scaled to a unit size and drawn 4 units away, the
+        // level of detail is chosen in model units
+        const float distance = 4.0f * _render->maxCoordinateValue();
+        const float projectionScale = view.drawableHeight /
+                (2.0f * tanf(GLKMathDegreesToRadians(65.0f) / 2.0f));
+        const size_t level = _render->lodLevel(distance, projectionScale);
+
+        // the groups outside the screen are not drawn
+        _render->draw(WavefrontFileReader::Frustum(_modelViewProjectionMatrix.m), level);
     }
 }
 
@@ -224,6 +245,9 @@ GLint uniforms[NUM_UNIFORMS];
     // Get uniform locations.
     uniforms[UNIFORM_MODELVIEWPROJECTION_MATRIX] = glGetUniformLocation(_program, "modelViewProjectionMatrix");
     uniforms[UNIFORM_NORMAL_MATRIX] = glGetUniformLocation(_program, "normalMatrix");
+    uniforms[UNIFORM_POSITION_OFFSET] = glGetUniformLocation(_program, "positionOffset");
+    uniforms[UNIFORM_POSITION_SCALE] = glGetUniformLocation(_program, "positionScale");
+    uniforms[UNIFORM_OCTAHEDRAL_NORMALS] = glGetUniformLocation(_program, "octahedralNormals");
 
     // Release vertex and fragment shaders.
     if (vertShader) {
@@ -312,27 +336,43 @@ GLint uniforms[NUM_UNIFORMS];
 
     NSString* path = self.objFiles[_renderFileIndex];
     _render.reset();
-    
-    self.nextButton.userInteractionEnabled = NO;
-
-    WavefrontFileReader::loadFile([path UTF8String], [self](std::shared_ptr<IObject> object) {
-        assert(object);
-        
-        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, 2 * NSEC_PER_SEC), dispatch_get_main_queue(), ^{
-            
-            if (object)
-            {
-                _render = std::unique_ptr<WavefrontRenderer>(new WavefrontRenderer(*object.get()));
-            }
-            
-            self.nextButton.userInteractionEnabled = YES;
-        });
-        
-    });
-    
+
+    // the previous file is skipped, its worker stops at the next step
+    if (_loading.valid()) {
+        _loading.cancel();
+    }
+
+    // parsing and building the buffer don't block the main thread
+    _loading = WavefrontFileReader::loadFileAsync([path UTF8String],
+                                                  WavefrontRenderer::bufferOptions());
+
     self.fileNameLabel.text = [path lastPathComponent];
 }
 
+- (void)finishLoading {
+    if (!_loading.valid()) {
+        return;
+    }
+
+    NSString* name = [self.objFiles[_renderFileIndex] lastPathComponent];
+
+    if (!_loading.ready()) {
+        self.fileNameLabel.text = [NSString stringWithFormat:@"%@ %d%%", name,
+                                   int(_loading.progress() * 100.0f)];
+        return;
+    }
+
+    try {
+        auto object = _loading.get();
+        _render = std::unique_ptr<WavefrontRenderer>(new WavefrontRenderer(*object.get()));
+    } catch (const std::exception& e) {
+        NSLog(@"Failed to load %@: %s", name, e.what());
+    }
+
+    _loading = WavefrontFileReader::LoadHandle();
+    self.fileNameLabel.text = name;
+}
+
 - (IBAction)moveToNextFileAction:(id)sender {
     ++_renderFileIndex;
 
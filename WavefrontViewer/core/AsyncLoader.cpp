@@ -0,0 +1,172 @@
+//
+//  AsyncLoader.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include "AsyncLoader.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+
+#include "WavefrontFileReader.h"
+#include "WavefrontObject.hpp"
+#include "MappedFile.h"
+#include "ThreadPool.h"
+
+namespace WavefrontFileReader
+{
+    /**
+     * Load state shared by the handles and the worker
+     */
+    struct LoadHandle::State
+    {
+        std::atomic<bool> cancelled; /// set by @see LoadHandle::cancel
+        std::atomic<size_t> bytesLoaded; /// bytes parsed so far
+        std::atomic<size_t> bytesTotal; /// file size
+
+        std::promise<std::shared_ptr<IObject>> promise; /// set by the worker
+        std::shared_future<std::shared_ptr<IObject>> result; /// read by the handles
+
+        State()
+        : cancelled(false), bytesLoaded(0), bytesTotal(0),
+          result(promise.get_future().share()) {}
+    };
+
+    namespace
+    {
+        /**
+         * Load the file, the cancellation is checked between the steps
+         * @param options - builds the vertex buffer when not nullptr
+         */
+        std::shared_ptr<IObject> load(LoadHandle::State& state, const std::string& filePath,
+                                      const VertexBufferOptions* options)
+        {
+            if( state.cancelled )
+            {
+                throw LoadCancelled();
+            }
+
+            MappedFile file(filePath);
+            state.bytesTotal = file.size();
+
+            auto object = loadBuffer(file.data(), file.size(), [&state](size_t bytesParsed) {
+                state.bytesLoaded = bytesParsed;
+                return !state.cancelled;
+            });
+
+            if( !object || state.cancelled )
+            {
+                throw LoadCancelled();
+            }
+
+            if( options != nullptr )
+            {
+                static_cast<const Object&>(*object).generateVertexBuffers(*options);
+                if( state.cancelled )
+                {
+                    throw LoadCancelled();
+                }
+            }
+
+            return object;
+        }
+
+        /**
+         * Start the load on the shared thread pool
+         * @param options - builds the vertex buffer when not nullptr
+         * @param func - receives the result when set
+         */
+        LoadHandle startLoad(const std::string& filePath,
+                             std::shared_ptr<const VertexBufferOptions> options,
+                             std::function<void(std::shared_ptr<IObject> object)> func)
+        {
+            auto state = std::make_shared<LoadHandle::State>();
+
+            // the task owns the state too, the handles can be dropped at once
+            ThreadPool::shared().submit([state, filePath, options, func]() {
+                std::shared_ptr<IObject> object;
+                try
+                {
+                    object = load(*state, filePath, options.get());
+                    state->promise.set_value(object);
+                }
+                catch( ... )
+                {
+                    state->promise.set_exception(std::current_exception());
+                }
+
+                if( func )
+                {
+                    func(object);
+                }
+            });
+
+            return LoadHandle(state);
+        }
+    }
+
+    bool LoadHandle::ready() const
+    {
+        return m_state->result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    void LoadHandle::wait() const
+    {
+        m_state->result.wait();
+    }
+
+    std::shared_ptr<IObject> LoadHandle::get() const
+    {
+        return m_state->result.get();
+    }
+
+    void LoadHandle::cancel()
+    {
+        m_state->cancelled = true;
+    }
+
+    bool LoadHandle::cancelled() const
+    {
+        return m_state->cancelled;
+    }
+
+    size_t LoadHandle::bytesLoaded() const
+    {
+        return m_state->bytesLoaded;
+    }
+
+    size_t LoadHandle::bytesTotal() const
+    {
+        return m_state->bytesTotal;
+    }
+
+    float LoadHandle::progress() const
+    {
+        const size_t total = m_state->bytesTotal;
+        if( total == 0 )
+        {
+            return ready() ? 1.0f : 0.0f;
+        }
+        return float(double(m_state->bytesLoaded) / double(total));
+    }
+
+    LoadHandle loadFileAsync(const std::string& filePath)
+    {
+        return startLoad(filePath, nullptr, nullptr);
+    }
+
+    LoadHandle loadFileAsync(const std::string& filePath, const VertexBufferOptions& options)
+    {
+        return startLoad(filePath, std::make_shared<const VertexBufferOptions>(options), nullptr);
+    }
+
+    LoadHandle loadFileAsync(const std::string& filePath,
+                             std::function<void(std::shared_ptr<IObject> object)> func)
+    {
+        return startLoad(filePath, nullptr, std::move(func));
+    }
+}
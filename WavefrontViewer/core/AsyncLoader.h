@@ -0,0 +1,109 @@
+//
+//  AsyncLoader.h
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#ifndef AsyncLoader_h
+#define AsyncLoader_h
+
+#include <memory>
+#include <string>
+#include <functional>
+#include <stdexcept>
+#include <cstddef>
+
+#include "IObject.h"
+
+namespace WavefrontFileReader
+{
+    /**
+     * Thrown by @see LoadHandle::get when the load was cancelled
+     */
+    class LoadCancelled : public std::runtime_error
+    {
+    public:
+        LoadCancelled() : std::runtime_error("Load cancelled") {}
+    };
+
+    /**
+     * Load running on the shared thread pool. Copies of a handle refer to
+     * the same load. Dropping the handles doesn't wait for the load, it runs
+     * until the end or until it sees it was cancelled.
+     */
+    class LoadHandle
+    {
+    public:
+        struct State;
+
+        /// Handle without a load, @see valid
+        LoadHandle() {}
+        explicit LoadHandle(std::shared_ptr<State> state) : m_state(std::move(state)) {}
+
+        /// The handle refers to a load
+        bool valid() const { return m_state != nullptr; }
+
+        /// The load finished, @see get doesn't block
+        bool ready() const;
+
+        /// Block until the load finishes
+        void wait() const;
+
+        /**
+         * Wait for the loaded object
+         * @throw LoadCancelled if the load was cancelled, or the error that
+         *          stopped the load, for example std::runtime_error for a
+         *          missing file
+         */
+        std::shared_ptr<IObject> get() const;
+
+        /**
+         * Ask the load to stop. The worker checks it between steps, so it
+         * stops after at most @see kProgressStep more bytes
+         */
+        void cancel();
+
+        /// @see cancel was called
+        bool cancelled() const;
+
+        /// Bytes parsed so far
+        size_t bytesLoaded() const;
+
+        /// File size, 0 until the file is opened
+        size_t bytesTotal() const;
+
+        /// Fraction of the file that was parsed, from 0 to 1
+        float progress() const;
+
+    private:
+        std::shared_ptr<State> m_state; /// shared with the worker
+    };
+
+    /**
+     * Load and parse a Wavefront file on a worker thread. Returns at once.
+     * @param filePath - full path to the Wavefront file
+     */
+    LoadHandle loadFileAsync(const std::string& filePath);
+
+    /**
+     * Load a Wavefront file and build its vertex buffer on a worker thread.
+     * Returns at once.
+     * @param filePath - full path to the Wavefront file
+     * @param options - how the vertex buffer is built
+     */
+    LoadHandle loadFileAsync(const std::string& filePath, const VertexBufferOptions& options);
+
+    /**
+     * Load and parse a Wavefront file on a worker thread and hand the result
+     * to a function. Returns at once.
+     * @param filePath - full path to the Wavefront file
+     * @param func - called on the worker thread with the object, or nullptr
+     *              when the load failed or was cancelled
+     */
+    LoadHandle loadFileAsync(const std::string& filePath,
+                             std::function<void(std::shared_ptr<IObject> object)> func);
+}
+
+#endif /* AsyncLoader_h */
@@ -0,0 +1,317 @@
+//
+//  BatchLoader.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include "BatchLoader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
+
+#include <sys/stat.h>
+
+#include "WavefrontFileReader.h"
+#include "WavefrontObject.hpp"
+#include "MappedFile.h"
+
+namespace WavefrontFileReader
+{
+    namespace
+    {
+        /// Distance between the bytes read to load the pages of a file
+        const size_t kPageSize = 4096;
+
+        /**
+         * File going through the stages
+         */
+        struct FileLoad
+        {
+            BatchResult result; /// returned after the last stage
+            std::unique_ptr<MappedFile> file; /// content until it is parsed
+        };
+
+        /// Size of a file, 0 when it doesn't exist
+        size_t fileSize(const std::string& filePath)
+        {
+            struct stat info;
+            return (stat(filePath.c_str(), &info) == 0) ? size_t(info.st_size) : 0;
+        }
+    }
+
+    /**
+     * Batch state shared by the loader and the stages
+     */
+    struct BatchLoader::State
+    {
+        State(const std::vector<std::string>& p, const BatchOptions& o, ThreadPool& t)
+        : paths(p), options(o), pool(t),
+          maxFiles((o.maxFilesInFlight > 0) ? o.maxFilesInFlight : 4 * size_t(t.threadCount())),
+          start(std::chrono::steady_clock::now()) {}
+
+        const std::vector<std::string> paths; /// files of the batch
+        const BatchOptions options; /// how the files are loaded
+        ThreadPool& pool; /// runs the stages
+        const size_t maxFiles; /// maximum number of files in flight
+
+        mutable std::mutex mutex; /// guards the members below
+        std::condition_variable changed; /// a file finished its last stage
+
+        size_t nextFile = 0; /// next file to start
+        size_t nextResult = 0; /// next file to return in order
+        size_t filesInFlight = 0; /// started and not returned
+        size_t bytesInFlight = 0; /// size of the files in flight
+        size_t running = 0; /// files still going through the stages
+        bool cancelled = false; /// no file is started anymore
+
+        std::map<size_t, BatchResult> finished; /// not returned yet, by index
+        std::deque<size_t> completion; /// indices of finished, in completion order
+
+        BatchStatistics statistics; /// throughput so far
+        const std::chrono::steady_clock::time_point start; /// the batch start
+    };
+
+    namespace
+    {
+        typedef std::shared_ptr<BatchLoader::State> StatePtr;
+
+        /// Last stage of a file, its result can be returned
+        void finish(const StatePtr& state, const std::shared_ptr<FileLoad>& load)
+        {
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+
+                BatchResult& result = load->result;
+                auto& statistics = state->statistics;
+                if( result.object )
+                {
+                    ++statistics.files;
+                    statistics.bytes += result.bytes;
+                }
+                else
+                {
+                    ++statistics.failed;
+                }
+                const std::chrono::duration<double> elapsed =
+                    std::chrono::steady_clock::now() - state->start;
+                statistics.seconds = elapsed.count();
+
+                state->completion.push_back(result.index);
+                state->finished[result.index] = std::move(result);
+                --state->running;
+            }
+            state->changed.notify_all();
+        }
+
+        /// End a file without its object
+        void fail(const StatePtr& state, const std::shared_ptr<FileLoad>& load,
+                  const std::string& error)
+        {
+            load->file.reset();
+            load->result.object.reset();
+            load->result.error = error;
+            finish(state, load);
+        }
+
+        /// Run a stage, an exception ends the file with its error
+        template<class Stage>
+        void runStage(const StatePtr& state, const std::shared_ptr<FileLoad>& load, Stage stage)
+        {
+            try
+            {
+                stage();
+            }
+            catch( const std::exception& e )
+            {
+                fail(state, load, e.what());
+            }
+            catch( ... )
+            {
+                fail(state, load, "Unknown error");
+            }
+        }
+
+        /// Third stage, build the vertex buffer
+        void buildStage(const StatePtr& state, const std::shared_ptr<FileLoad>& load)
+        {
+            runStage(state, load, [&state, &load]() {
+                const Object& object = static_cast<const Object&>(*load->result.object);
+                object.generateVertexBuffers(state->options.bufferOptions);
+                finish(state, load);
+            });
+        }
+
+        /// Second stage, parse the content
+        void parseStage(const StatePtr& state, const std::shared_ptr<FileLoad>& load)
+        {
+            runStage(state, load, [&state, &load]() {
+                load->result.object = loadBuffer(load->file->data(), load->file->size());
+                load->file.reset();
+
+                if( state->options.buildVertexBuffers )
+                {
+                    state->pool.submit([state, load]() { buildStage(state, load); });
+                }
+                else
+                {
+                    finish(state, load);
+                }
+            });
+        }
+
+        /// First stage, map the file and read its pages
+        void readStage(const StatePtr& state, const std::shared_ptr<FileLoad>& load)
+        {
+            runStage(state, load, [&state, &load]() {
+                load->file.reset(new MappedFile(load->result.path));
+
+                // the parser finds the pages in memory instead of waiting for them
+                const char* data = load->file->data();
+                char sum = 0;
+                for( size_t i = 0; i < load->file->size(); i += kPageSize )
+                {
+                    sum ^= data[i];
+                }
+                volatile char sink = sum;
+                (void)sink;
+
+                state->pool.submit([state, load]() { parseStage(state, load); });
+            });
+        }
+
+        /// Start the next files while they fit the limits. The mutex is locked
+        void startFiles(const StatePtr& state)
+        {
+            const BatchOptions& options = state->options;
+            while( !state->cancelled && (state->nextFile < state->paths.size()) &&
+                   (state->filesInFlight < state->maxFiles) )
+            {
+                const std::string& path = state->paths[state->nextFile];
+                const size_t bytes = fileSize(path);
+
+                // a file larger than the limit is loaded alone
+                if( (state->filesInFlight > 0) &&
+                    (state->bytesInFlight + bytes > options.maxBytesInFlight) )
+                {
+                    break;
+                }
+
+                auto load = std::make_shared<FileLoad>();
+                load->result.index = state->nextFile;
+                load->result.path = path;
+                load->result.bytes = bytes;
+
+                ++state->nextFile;
+                ++state->filesInFlight;
+                ++state->running;
+                state->bytesInFlight += bytes;
+                state->statistics.peakBytesInFlight = std::max(state->statistics.peakBytesInFlight,
+                                                               state->bytesInFlight);
+
+                state->pool.submit([state, load]() { readStage(state, load); });
+            }
+        }
+    }
+
+    BatchLoader::BatchLoader(const std::vector<std::string>& paths, const BatchOptions& options,
+                             ThreadPool& pool)
+    : m_state(std::make_shared<State>(paths, options, pool))
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        startFiles(m_state);
+    }
+
+    BatchLoader::~BatchLoader()
+    {
+        std::unique_lock<std::mutex> lock(m_state->mutex);
+        m_state->cancelled = true;
+        m_state->changed.wait(lock, [this]() { return m_state->running == 0; });
+    }
+
+    bool BatchLoader::next(BatchResult& result)
+    {
+        State& state = *m_state;
+        std::unique_lock<std::mutex> lock(state.mutex);
+
+        std::map<size_t, BatchResult>::iterator it;
+        while( true )
+        {
+            if( state.options.ordered )
+            {
+                it = state.finished.find(state.nextResult);
+            }
+            else
+            {
+                it = state.completion.empty() ? state.finished.end()
+                                              : state.finished.find(state.completion.front());
+            }
+
+            if( it != state.finished.end() )
+            {
+                break;
+            }
+
+            // the files that were not started are never returned
+            if( state.filesInFlight == 0 )
+            {
+                return false;
+            }
+            state.changed.wait(lock);
+        }
+
+        result = std::move(it->second);
+        state.finished.erase(it);
+        state.completion.erase(std::find(state.completion.begin(), state.completion.end(),
+                                         result.index));
+        ++state.nextResult;
+
+        // the memory of the file isn't used by the loader anymore
+        --state.filesInFlight;
+        state.bytesInFlight -= result.bytes;
+        startFiles(m_state);
+
+        return true;
+    }
+
+    void BatchLoader::cancel()
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        m_state->cancelled = true;
+    }
+
+    BatchStatistics BatchLoader::statistics() const
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        return m_state->statistics;
+    }
+
+    std::vector<BatchResult> loadFiles(const std::vector<std::string>& paths,
+                                       const BatchOptions& options, BatchStatistics* statistics)
+    {
+        BatchOptions ordered = options;
+        ordered.ordered = true;
+
+        BatchLoader loader(paths, ordered);
+        std::vector<BatchResult> results;
+        results.reserve(paths.size());
+
+        BatchResult result;
+        while( loader.next(result) )
+        {
+            results.push_back(std::move(result));
+        }
+
+        if( statistics != nullptr )
+        {
+            *statistics = loader.statistics();
+        }
+        return results;
+    }
+}
@@ -0,0 +1,131 @@
+//
+//  BatchLoader.h
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#ifndef BatchLoader_h
+#define BatchLoader_h
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+#include "IObject.h"
+#include "ThreadPool.h"
+
+namespace WavefrontFileReader
+{
+    /**
+     * Options of a @see BatchLoader
+     */
+    struct BatchOptions
+    {
+        /// Build the vertex buffer of every object with bufferOptions
+        bool buildVertexBuffers = true;
+        VertexBufferOptions bufferOptions;
+
+        /// Results are returned in the order of the paths. Otherwise they
+        /// are returned as soon as they are ready
+        bool ordered = true;
+
+        /// Maximum size of the files that are loaded or wait to be returned.
+        /// A larger file is loaded alone
+        size_t maxBytesInFlight = 256 * 1024 * 1024;
+
+        /// Maximum number of files that are loaded or wait to be returned,
+        /// 0 for four times the pool threads
+        size_t maxFilesInFlight = 0;
+    };
+
+    /**
+     * Loaded file of a batch
+     */
+    struct BatchResult
+    {
+        size_t index = 0; /// position of the path in the batch
+        std::string path; /// full path to the Wavefront file
+        size_t bytes = 0; /// file size when it was started
+        std::shared_ptr<IObject> object; /// nullptr when the load failed
+        std::string error; /// why the load failed
+    };
+
+    /**
+     * Throughput of a batch
+     */
+    struct BatchStatistics
+    {
+        size_t files = 0; /// files loaded
+        size_t failed = 0; /// files that couldn't be loaded
+        size_t bytes = 0; /// size of the loaded files
+        double seconds = 0.0; /// from the start to the last loaded file
+        size_t peakBytesInFlight = 0; /// largest size of the files in flight
+
+        double filesPerSecond() const { return (seconds > 0.0) ? files / seconds : 0.0; }
+        double megabytesPerSecond() const
+        { return (seconds > 0.0) ? (bytes / (1024.0 * 1024.0)) / seconds : 0.0; }
+    };
+
+    /**
+     * Load many Wavefront files on the shared thread pool. Every file goes
+     * through three stages: the file is mapped and read, parsed, and its
+     * vertex buffer is built. Every stage is a task of its own, so the
+     * files are pipelined: some are read while others are parsed or built.
+     * New files are started only while the files in flight fit the limits
+     * of @see BatchOptions.
+     */
+    class BatchLoader
+    {
+    public:
+        /**
+         * Start loading the files
+         * @param paths - full paths to the Wavefront files
+         * @param options - how the files are loaded and returned
+         * @param pool - runs the stages
+         */
+        explicit BatchLoader(const std::vector<std::string>& paths,
+                             const BatchOptions& options = BatchOptions(),
+                             ThreadPool& pool = ThreadPool::shared());
+
+        /// Cancel the batch and wait for the files in flight
+        ~BatchLoader();
+
+        BatchLoader(const BatchLoader&) = delete;
+        BatchLoader& operator= (const BatchLoader&) = delete;
+
+        /**
+         * Wait for the next loaded file. Failed files are returned too, with
+         * their error
+         * @return false when every file was returned
+         */
+        bool next(BatchResult& result);
+
+        /**
+         * Stop starting new files. The files in flight are still returned,
+         * the others never are
+         */
+        void cancel();
+
+        /// Throughput so far
+        BatchStatistics statistics() const;
+
+        struct State;
+
+    private:
+        std::shared_ptr<State> m_state; /// shared with the stages
+    };
+
+    /**
+     * Load many Wavefront files, @see BatchLoader
+     * @param statistics - receives the throughput when not nullptr
+     * @return the results in the order of the paths
+     */
+    std::vector<BatchResult> loadFiles(const std::vector<std::string>& paths,
+                                       const BatchOptions& options = BatchOptions(),
+                                       BatchStatistics* statistics = nullptr);
+}
+
+#endif /* BatchLoader_h */
@@ -0,0 +1,531 @@
+//
+//  BinaryCache.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include "BinaryCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <sys/stat.h>
+
+#include "WavefrontFileReader.h"
+#include "WavefrontObject.hpp"
+
+namespace WavefrontFileReader
+{
+    namespace
+    {
+        /// First bytes of every cache file
+        const char kMagic[8] = { 'W', 'F', 'C', 'A', 'C', 'H', 'E', '\0' };
+
+        /// Written in the machine byte order, caches from other machines are rebuilt
+        const uint32_t kByteOrder = 0x01020304;
+
+        /// Alignment of every section from the file start
+        const uint64_t kAlignment = 16;
+
+        /// Arrays stored in a cache, in file order
+        enum Section
+        {
+            Vertices,     /// vertices in the layout format
+            Indices,      /// indices of indexSize bytes
+            Commands,     /// @see Command of the full detail
+            LodLevels,    /// @see CachedLod
+            LodCommands,  /// commands of all the levels of detail
+            Meshlets,     /// @see Meshlet
+            Positions,    /// IObject::vertices
+            TexCoords,    /// IObject::texCoords
+            Normals,      /// IObject::normals
+            Meshes,       /// @see CachedMesh
+            FaceIndices,  /// indices of the faces of all the meshes
+            FaceOffsets,  /// face offsets of all the meshes
+            MeshNames,    /// names of all the meshes, not null terminated
+            SectionsCount
+        };
+
+        /**
+         * Bytes of a section
+         */
+        struct SectionRange
+        {
+            uint64_t offset = 0; /// bytes from the file start
+            uint64_t size = 0; /// size in bytes
+        };
+
+        /**
+         * @see LodLevel without its commands
+         */
+        struct CachedLod
+        {
+            float ratio; /// @see LodLevel::ratio
+            float error; /// @see LodLevel::error
+            uint32_t firstCommand; /// first command in the LodCommands section
+            uint32_t commandsCount; /// number of commands
+        };
+
+        /**
+         * @see Mesh without its arrays
+         */
+        struct CachedMesh
+        {
+            uint64_t nameOffset; /// first character in the MeshNames section
+            uint64_t nameSize; /// number of characters
+            uint64_t firstIndex; /// first index in the FaceIndices section
+            uint64_t indicesCount; /// number of face indices
+            uint64_t firstOffset; /// first offset in the FaceOffsets section
+            uint64_t offsetsCount; /// number of face offsets, faces count + 1
+            int32_t numberOfElementsInFace; /// @see Mesh::numberOfElementsInFace
+            Bounds bounds; /// @see Mesh::bounds
+        };
+
+        /**
+         * Size and modification time of a file, in nanoseconds
+         * @return Returns false when the file doesn't exist
+         */
+        bool sourceInfo(const std::string& filePath, int64_t& size, int64_t& time)
+        {
+            struct stat info;
+            if( stat(filePath.c_str(), &info) != 0 )
+            {
+                return false;
+            }
+
+            size = int64_t(info.st_size);
+#if defined(__APPLE__)
+            time = int64_t(info.st_mtimespec.tv_sec) * 1000000000 + info.st_mtimespec.tv_nsec;
+#else
+            time = int64_t(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+#endif
+            return true;
+        }
+    }
+
+    /**
+     * First bytes of a cache file
+     */
+    struct CacheHeader
+    {
+        char magic[8]; /// @see kMagic
+        uint32_t version; /// @see kCacheVersion
+        uint32_t headerSize; /// size of this header
+        uint32_t byteOrder; /// @see kByteOrder
+        uint32_t vertexSize; /// sizes of the stored structures, they change
+        uint32_t commandSize; /// with the compiler and the sources
+        uint32_t meshletSize;
+        uint32_t hasObject; /// the raw arrays of the object are stored
+        uint32_t indexSize; /// @see VertexBuffer::indexSize
+        uint64_t optionsKey; /// @see optionsKey
+        int64_t sourceSize; /// size of the Wavefront file, -1 when not known
+        int64_t sourceTime; /// modification time of the Wavefront file
+        float scale; /// @see VertexBuffer::scale
+        VertexLayout layout; /// @see VertexBuffer::layout
+        Bounds bounds; /// @see IObject::bounds
+        SectionRange sections[SectionsCount]; /// stored arrays
+    };
+
+    std::string cachePath(const std::string& filePath)
+    {
+        return filePath + ".cache";
+    }
+
+    void saveCache(const std::string& cachePath, const VertexBuffer& buffer,
+                   const VertexBufferOptions& options, const IObject* object,
+                   const std::string& sourcePath)
+    {
+        CacheHeader header;
+        std::memset(static_cast<void*>(&header), 0, sizeof(header));
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kCacheVersion;
+        header.headerSize = sizeof(CacheHeader);
+        header.byteOrder = kByteOrder;
+        header.vertexSize = sizeof(Vertex);
+        header.commandSize = sizeof(Command);
+        header.meshletSize = sizeof(Meshlet);
+        header.hasObject = (object != nullptr) ? 1 : 0;
+        header.indexSize = buffer.indexSize;
+        header.optionsKey = optionsKey(options);
+        header.scale = buffer.scale;
+        header.layout = buffer.layout;
+        header.bounds = (object != nullptr) ? object->bounds : Bounds();
+
+        if( !sourceInfo(sourcePath, header.sourceSize, header.sourceTime) )
+        {
+            header.sourceSize = -1;
+        }
+
+        // an interrupted write never leaves a broken cache
+        const std::string temporaryPath = cachePath + ".tmp";
+        std::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+        if( !stream )
+        {
+            throw std::runtime_error("Could not write cache");
+        }
+
+        // the header is written again when the sections are known
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        uint64_t offset = sizeof(header);
+
+        auto write = [&](Section section, const void* data, size_t size) {
+            static const char padding[kAlignment] = {};
+            const uint64_t aligned = (offset + kAlignment - 1) / kAlignment * kAlignment;
+            stream.write(padding, std::streamsize(aligned - offset));
+
+            header.sections[section].offset = aligned;
+            header.sections[section].size = size;
+            stream.write(static_cast<const char*>(data), std::streamsize(size));
+            offset = aligned + size;
+        };
+
+        if( buffer.layout.format == VertexLayout::Float32 )
+        {
+            write(Vertices, buffer.vbo.data(), buffer.vbo.size() * sizeof(Vertex));
+        }
+        else
+        {
+            write(Vertices, buffer.packedVbo.data(), buffer.packedVbo.size());
+        }
+
+        if( buffer.indexSize == 2 )
+        {
+            write(Indices, buffer.ibo16.data(), buffer.ibo16.size() * sizeof(uint16_t));
+        }
+        else
+        {
+            write(Indices, buffer.ibo.data(), buffer.ibo.size() * sizeof(uint32_t));
+        }
+
+        write(Commands, buffer.commands.data(), buffer.commands.size() * sizeof(Command));
+
+        std::vector<CachedLod> lods;
+        std::vector<Command> lodCommands;
+        for( const auto& lod : buffer.lods )
+        {
+            CachedLod cached;
+            cached.ratio = lod.ratio;
+            cached.error = lod.error;
+            cached.firstCommand = uint32_t(lodCommands.size());
+            cached.commandsCount = uint32_t(lod.commands.size());
+            lods.push_back(cached);
+            lodCommands.insert(lodCommands.end(), lod.commands.begin(), lod.commands.end());
+        }
+        write(LodLevels, lods.data(), lods.size() * sizeof(CachedLod));
+        write(LodCommands, lodCommands.data(), lodCommands.size() * sizeof(Command));
+
+        write(Meshlets, buffer.meshlets.data(), buffer.meshlets.size() * sizeof(Meshlet));
+
+        if( object != nullptr )
+        {
+            write(Positions, object->vertices.data(), object->vertices.size() * sizeof(fvec3));
+            write(TexCoords, object->texCoords.data(), object->texCoords.size() * sizeof(fvec3));
+            write(Normals, object->normals.data(), object->normals.size() * sizeof(fvec3));
+
+            std::vector<CachedMesh> meshes;
+            std::string names;
+            uint64_t indicesCount = 0, offsetsCount = 0;
+            for( const auto& mesh : object->meshes )
+            {
+                CachedMesh cached;
+                std::memset(static_cast<void*>(&cached), 0, sizeof(cached));
+                cached.nameOffset = names.size();
+                cached.nameSize = mesh.name.size();
+                cached.firstIndex = indicesCount;
+                cached.indicesCount = mesh.faces.indices().size();
+                cached.firstOffset = offsetsCount;
+                cached.offsetsCount = mesh.faces.offsets().size();
+                cached.numberOfElementsInFace = mesh.numberOfElementsInFace;
+                cached.bounds = mesh.bounds;
+                meshes.push_back(cached);
+
+                names += mesh.name;
+                indicesCount += cached.indicesCount;
+                offsetsCount += cached.offsetsCount;
+            }
+            write(Meshes, meshes.data(), meshes.size() * sizeof(CachedMesh));
+
+            // the face arrays of the meshes follow each other
+            write(FaceIndices, nullptr, 0);
+            for( const auto& mesh : object->meshes )
+            {
+                const auto& indices = mesh.faces.indices();
+                stream.write(reinterpret_cast<const char*>(indices.data()),
+                             std::streamsize(indices.size() * sizeof(IndexData)));
+            }
+            header.sections[FaceIndices].size = indicesCount * sizeof(IndexData);
+            offset += header.sections[FaceIndices].size;
+
+            write(FaceOffsets, nullptr, 0);
+            for( const auto& mesh : object->meshes )
+            {
+                const auto& offsets = mesh.faces.offsets();
+                stream.write(reinterpret_cast<const char*>(offsets.data()),
+                             std::streamsize(offsets.size() * sizeof(uint32_t)));
+            }
+            header.sections[FaceOffsets].size = offsetsCount * sizeof(uint32_t);
+            offset += header.sections[FaceOffsets].size;
+
+            write(MeshNames, names.data(), names.size());
+        }
+
+        stream.seekp(0);
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        stream.close();
+
+        if( !stream || (std::rename(temporaryPath.c_str(), cachePath.c_str()) != 0) )
+        {
+            std::remove(temporaryPath.c_str());
+            throw std::runtime_error("Could not write cache");
+        }
+    }
+
+    CacheFile::CacheFile(const std::string& cachePath)
+    : m_file(cachePath)
+    {
+        const uint64_t fileSize = m_file.size();
+        if( fileSize < sizeof(CacheHeader) )
+        {
+            throw std::runtime_error("Invalid cache file");
+        }
+
+        m_header = reinterpret_cast<const CacheHeader*>(m_file.data());
+        if( (std::memcmp(m_header->magic, kMagic, sizeof(kMagic)) != 0) ||
+            (m_header->version != kCacheVersion) ||
+            (m_header->headerSize != sizeof(CacheHeader)) ||
+            (m_header->byteOrder != kByteOrder) ||
+            (m_header->vertexSize != sizeof(Vertex)) ||
+            (m_header->commandSize != sizeof(Command)) ||
+            (m_header->meshletSize != sizeof(Meshlet)) ||
+            ((m_header->indexSize != 2) && (m_header->indexSize != 4)) )
+        {
+            throw std::runtime_error("Invalid cache file");
+        }
+
+        for( const auto& range : m_header->sections )
+        {
+            if( (range.offset % kAlignment != 0) || (range.offset > fileSize) ||
+                (range.size > fileSize - range.offset) )
+            {
+                throw std::runtime_error("Invalid cache file");
+            }
+        }
+
+        // the levels and meshes point inside other sections
+        const auto lodCommands = section<Command>(LodCommands);
+        for( const auto& lod : section<CachedLod>(LodLevels) )
+        {
+            if( uint64_t(lod.firstCommand) + lod.commandsCount > lodCommands.size() )
+            {
+                throw std::runtime_error("Invalid cache file");
+            }
+        }
+
+        const uint64_t indicesCount = section<IndexData>(FaceIndices).size();
+        const uint64_t offsetsCount = section<uint32_t>(FaceOffsets).size();
+        const uint64_t namesSize = section<char>(MeshNames).size();
+        for( const auto& mesh : section<CachedMesh>(Meshes) )
+        {
+            if( (mesh.firstIndex > indicesCount) || (mesh.indicesCount > indicesCount - mesh.firstIndex) ||
+                (mesh.firstOffset > offsetsCount) || (mesh.offsetsCount > offsetsCount - mesh.firstOffset) ||
+                (mesh.nameOffset > namesSize) || (mesh.nameSize > namesSize - mesh.nameOffset) )
+            {
+                throw std::runtime_error("Invalid cache file");
+            }
+        }
+    }
+
+    template<class T>
+    ArrayView<T> CacheFile::section(size_t i) const
+    {
+        const SectionRange& range = m_header->sections[i];
+        const T* begin = reinterpret_cast<const T*>(m_file.data() + range.offset);
+        return ArrayView<T>(begin, begin + range.size / sizeof(T));
+    }
+
+    bool CacheFile::isValidFor(const std::string& sourcePath,
+                               const VertexBufferOptions& options) const
+    {
+        int64_t size = 0, time = 0;
+        return sourceInfo(sourcePath, size, time) && (size == m_header->sourceSize) &&
+               (time == m_header->sourceTime) && (optionsKey(options) == m_header->optionsKey);
+    }
+
+    const VertexLayout& CacheFile::layout() const
+    {
+        return m_header->layout;
+    }
+
+    unsigned CacheFile::indexSize() const
+    {
+        return m_header->indexSize;
+    }
+
+    float CacheFile::scale() const
+    {
+        return m_header->scale;
+    }
+
+    ArrayView<uint8_t> CacheFile::vertexData() const
+    {
+        return section<uint8_t>(Vertices);
+    }
+
+    ArrayView<uint8_t> CacheFile::indexData() const
+    {
+        return section<uint8_t>(Indices);
+    }
+
+    ArrayView<Command> CacheFile::commands() const
+    {
+        return section<Command>(Commands);
+    }
+
+    ArrayView<Meshlet> CacheFile::meshlets() const
+    {
+        return section<Meshlet>(Meshlets);
+    }
+
+    std::vector<LodLevel> CacheFile::lods() const
+    {
+        const auto commands = section<Command>(LodCommands);
+
+        std::vector<LodLevel> lods;
+        for( const auto& cached : section<CachedLod>(LodLevels) )
+        {
+            LodLevel lod;
+            lod.ratio = cached.ratio;
+            lod.error = cached.error;
+            lod.commands.assign(commands.begin() + cached.firstCommand,
+                                commands.begin() + cached.firstCommand + cached.commandsCount);
+            lods.push_back(std::move(lod));
+        }
+        return lods;
+    }
+
+    bool CacheFile::hasObject() const
+    {
+        return m_header->hasObject != 0;
+    }
+
+    VertexBuffer CacheFile::vertexBuffer() const
+    {
+        VertexBuffer buffer;
+        buffer.layout = layout();
+        buffer.indexSize = indexSize();
+        buffer.scale = scale();
+
+        if( buffer.layout.format == VertexLayout::Float32 )
+        {
+            const auto vertices = section<Vertex>(Vertices);
+            buffer.vbo.assign(vertices.begin(), vertices.end());
+        }
+        else
+        {
+            const auto vertices = vertexData();
+            buffer.packedVbo.assign(vertices.begin(), vertices.end());
+        }
+
+        if( buffer.indexSize == 2 )
+        {
+            const auto indices = section<uint16_t>(Indices);
+            buffer.ibo16.assign(indices.begin(), indices.end());
+        }
+        else
+        {
+            const auto indices = section<uint32_t>(Indices);
+            buffer.ibo.assign(indices.begin(), indices.end());
+        }
+
+        const auto commandsView = commands();
+        buffer.commands.assign(commandsView.begin(), commandsView.end());
+
+        const auto meshletsView = meshlets();
+        buffer.meshlets.assign(meshletsView.begin(), meshletsView.end());
+
+        buffer.lods = lods();
+        return buffer;
+    }
+
+    std::shared_ptr<IObject> CacheFile::object() const
+    {
+        if( !hasObject() )
+        {
+            throw std::runtime_error("The cache has no object");
+        }
+
+        std::shared_ptr<IObject> objPtr = std::shared_ptr<IObject>(new Object());
+        auto& object = *(Object*)(objPtr.get());
+
+        const auto positions = section<fvec3>(Positions);
+        object.vertices.assign(positions.begin(), positions.end());
+        const auto texCoords = section<fvec3>(TexCoords);
+        object.texCoords.assign(texCoords.begin(), texCoords.end());
+        const auto normals = section<fvec3>(Normals);
+        object.normals.assign(normals.begin(), normals.end());
+        object.bounds = m_header->bounds;
+
+        const auto indices = section<IndexData>(FaceIndices);
+        const auto offsets = section<uint32_t>(FaceOffsets);
+        const auto names = section<char>(MeshNames);
+        const auto meshes = section<CachedMesh>(Meshes);
+
+        object.meshes.resize(meshes.size());
+        for( size_t i = 0; i < meshes.size(); ++i )
+        {
+            const CachedMesh& cached = meshes[i];
+            Mesh& mesh = object.meshes[i];
+            mesh.name.assign(names.begin() + cached.nameOffset, size_t(cached.nameSize));
+            mesh.numberOfElementsInFace = cached.numberOfElementsInFace;
+            mesh.bounds = cached.bounds;
+            mesh.faces.assign(ArrayView<IndexData>(indices.begin() + cached.firstIndex,
+                                                   indices.begin() + cached.firstIndex +
+                                                   cached.indicesCount),
+                              ArrayView<uint32_t>(offsets.begin() + cached.firstOffset,
+                                                  offsets.begin() + cached.firstOffset +
+                                                  cached.offsetsCount));
+        }
+
+        object.m_vertexBuffer = vertexBuffer();
+        object.m_vertexBufferKey = m_header->optionsKey;
+        return objPtr;
+    }
+
+    std::shared_ptr<IObject> loadCachedFile(const std::string& filePath,
+                                            const VertexBufferOptions& options)
+    {
+        const std::string path = cachePath(filePath);
+
+        try
+        {
+            CacheFile cache(path);
+            if( cache.hasObject() && cache.isValidFor(filePath, options) )
+            {
+                return cache.object();
+            }
+        }
+        catch( const std::runtime_error& )
+        {
+            // missing or broken cache, it is built again
+        }
+
+        auto object = loadMappedFile(filePath);
+        const Object& wavefrontObject = *(Object*)(object.get());
+        wavefrontObject.generateVertexBuffers(options);
+
+        try
+        {
+            saveCache(path, wavefrontObject.vertexBuffer(), options, object.get(), filePath);
+        }
+        catch( const std::runtime_error& )
+        {
+            // read only directory, the file is parsed every time
+        }
+
+        return object;
+    }
+}
@@ -0,0 +1,131 @@
+//
+//  BinaryCache.h
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#ifndef BinaryCache_h
+#define BinaryCache_h
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+#include "IObject.h"
+#include "MappedFile.h"
+
+namespace WavefrontFileReader
+{
+    /// Version of the cache format. Caches with another version are rebuilt
+    const uint32_t kCacheVersion = 1;
+
+    struct CacheHeader;
+
+    /**
+     * Cache file used for a Wavefront file, next to it
+     * @param filePath - full path to the Wavefront file
+     */
+    std::string cachePath(const std::string& filePath);
+
+    /**
+     * Write a vertex buffer in the binary cache format. Every array is
+     * stored as it is in memory, 16 bytes aligned, after a versioned header,
+     * so a mapped cache is used without reading the elements. The file is
+     * written next to its final path and renamed when complete.
+     *
+     * @param cachePath - cache file path
+     * @param buffer - built vertex buffer
+     * @param options - options used to build the buffer
+     * @param object - object with the raw arrays to store, nullptr for none
+     * @param sourcePath - Wavefront file of the buffer. Its size and
+     *              modification time tell when the cache is stale
+     * @throw std::runtime_error if the file could not be written
+     */
+    void saveCache(const std::string& cachePath, const VertexBuffer& buffer,
+                   const VertexBufferOptions& options, const IObject* object,
+                   const std::string& sourcePath);
+
+    /**
+     * Binary cache mapped in memory. The vertices and indices are used from
+     * the mapping, for example to upload them to OpenGL
+     */
+    class CacheFile
+    {
+    public:
+        /**
+         * Map a cache file
+         * @param cachePath - cache file path
+         * @throw std::runtime_error if the file can't be mapped, isn't a cache
+         *          or has another version
+         */
+        explicit CacheFile(const std::string& cachePath);
+
+        /**
+         * Check if the cache was built from the current content of a file
+         * @param sourcePath - Wavefront file of the cache
+         * @param options - options the buffer must be built with
+         */
+        bool isValidFor(const std::string& sourcePath, const VertexBufferOptions& options) const;
+
+        /// Format of the vertices
+        const VertexLayout& layout() const;
+
+        /// Bytes used by an index
+        unsigned indexSize() const;
+
+        /// @see VertexBuffer::scale
+        float scale() const;
+
+        /// Vertices in the layout format, inside the mapping
+        ArrayView<uint8_t> vertexData() const;
+
+        /// Indices of indexSize bytes, inside the mapping
+        ArrayView<uint8_t> indexData() const;
+
+        /// Commands of the full detail
+        ArrayView<Command> commands() const;
+
+        /// @see VertexBuffer::meshlets
+        ArrayView<Meshlet> meshlets() const;
+
+        /// Levels of detail, their commands are copied
+        std::vector<LodLevel> lods() const;
+
+        /// The raw arrays of the object are stored
+        bool hasObject() const;
+
+        /// Copy of the vertex buffer
+        VertexBuffer vertexBuffer() const;
+
+        /**
+         * Copy of the object with its vertex buffer already built
+         * @throw std::runtime_error if the raw arrays are not stored
+         */
+        std::shared_ptr<IObject> object() const;
+
+    private:
+        /// Elements of a section
+        template<class T>
+        ArrayView<T> section(size_t i) const;
+
+        MappedFile m_file; /// cache content
+        const CacheHeader* m_header = nullptr; /// start of the mapping
+    };
+
+    /**
+     * Load a Wavefront file with its vertex buffer built. A valid cache next
+     * to the file is used instead of parsing it. Otherwise the file is
+     * parsed, the buffer built and the cache written again; a cache that
+     * can't be written, in a read only directory, is skipped.
+     *
+     * @param filePath - full path to the Wavefront file
+     * @param options - how the vertex buffer is built
+     */
+    std::shared_ptr<IObject> loadCachedFile(const std::string& filePath,
+                                            const VertexBufferOptions& options = VertexBufferOptions());
+}
+
+#endif /* BinaryCache_h */
@@ -0,0 +1,200 @@
+//
+//  Bounds.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include "Bounds.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace WavefrontFileReader
+{
+    namespace
+    {
+        static_assert(sizeof(fvec3) == 3 * sizeof(float), "points must be packed");
+
+        /**
+         * Smallest and largest coordinates of the points
+         * @param points - points to check
+         * @param count - number of points
+         * @param low - updated with the smallest coordinates
+         * @param high - updated with the largest coordinates
+         */
+        void minMax(const fvec3* points, size_t count, fvec3& low, fvec3& high)
+        {
+            size_t i = 0;
+
+#if defined(__SSE2__) || (defined(__aarch64__) && defined(__ARM_NEON))
+            if( count >= 4 )
+            {
+                // 4 points fill 3 vectors, x y z x | y z x y | z x y z, and
+                // every lane always sees the same coordinate
+                const float* data = &points[0].x;
+                float lows[12], highs[12];
+
+#if defined(__SSE2__)
+                __m128 low0 = _mm_loadu_ps(data), low1 = _mm_loadu_ps(data + 4);
+                __m128 low2 = _mm_loadu_ps(data + 8);
+                __m128 high0 = low0, high1 = low1, high2 = low2;
+
+                for( i = 4; i + 4 <= count; i += 4 )
+                {
+                    const float* p = data + 3 * i;
+                    const __m128 a = _mm_loadu_ps(p);
+                    const __m128 b = _mm_loadu_ps(p + 4);
+                    const __m128 c = _mm_loadu_ps(p + 8);
+
+                    low0 = _mm_min_ps(low0, a);
+                    low1 = _mm_min_ps(low1, b);
+                    low2 = _mm_min_ps(low2, c);
+                    high0 = _mm_max_ps(high0, a);
+                    high1 = _mm_max_ps(high1, b);
+                    high2 = _mm_max_ps(high2, c);
+                }
+
+                _mm_storeu_ps(lows, low0);
+                _mm_storeu_ps(lows + 4, low1);
+                _mm_storeu_ps(lows + 8, low2);
+                _mm_storeu_ps(highs, high0);
+                _mm_storeu_ps(highs + 4, high1);
+                _mm_storeu_ps(highs + 8, high2);
+#else
+                float32x4_t low0 = vld1q_f32(data), low1 = vld1q_f32(data + 4);
+                float32x4_t low2 = vld1q_f32(data + 8);
+                float32x4_t high0 = low0, high1 = low1, high2 = low2;
+
+                for( i = 4; i + 4 <= count; i += 4 )
+                {
+                    const float* p = data + 3 * i;
+                    const float32x4_t a = vld1q_f32(p);
+                    const float32x4_t b = vld1q_f32(p + 4);
+                    const float32x4_t c = vld1q_f32(p + 8);
+
+                    low0 = vminq_f32(low0, a);
+                    low1 = vminq_f32(low1, b);
+                    low2 = vminq_f32(low2, c);
+                    high0 = vmaxq_f32(high0, a);
+                    high1 = vmaxq_f32(high1, b);
+                    high2 = vmaxq_f32(high2, c);
+                }
+
+                vst1q_f32(lows, low0);
+                vst1q_f32(lows + 4, low1);
+                vst1q_f32(lows + 8, low2);
+                vst1q_f32(highs, high0);
+                vst1q_f32(highs + 4, high1);
+                vst1q_f32(highs + 8, high2);
+#endif
+
+                for( int k = 0; k < 12; k += 3 )
+                {
+                    low = fvec3(std::min(low.x, lows[k]), std::min(low.y, lows[k + 1]),
+                                std::min(low.z, lows[k + 2]));
+                    high = fvec3(std::max(high.x, highs[k]), std::max(high.y, highs[k + 1]),
+                                 std::max(high.z, highs[k + 2]));
+                }
+            }
+#endif
+
+            for( ; i < count; ++i )
+            {
+                const fvec3& p = points[i];
+                low = fvec3(std::min(low.x, p.x), std::min(low.y, p.y), std::min(low.z, p.z));
+                high = fvec3(std::max(high.x, p.x), std::max(high.y, p.y), std::max(high.z, p.z));
+            }
+        }
+
+        /// Set the sphere around the box center, radius is the farthest point
+        template<class PointAt>
+        void setSphere(Bounds& bounds, size_t count, PointAt pointAt)
+        {
+            if( bounds.empty() )
+            {
+                return;
+            }
+
+            bounds.center = (bounds.low + bounds.high) * 0.5f;
+
+            float radius = 0.0f;
+            for( size_t i = 0; i < count; ++i )
+            {
+                const fvec3 d = pointAt(i) - bounds.center;
+                radius = std::max(radius, dot(d, d));
+            }
+            bounds.radius = std::sqrt(radius);
+        }
+    }
+
+    Bounds computeBounds(const fvec3* points, size_t count)
+    {
+        Bounds bounds;
+        minMax(points, count, bounds.low, bounds.high);
+        setSphere(bounds, count, [points](size_t i) -> const fvec3& { return points[i]; });
+        return bounds;
+    }
+
+    Bounds commandBounds(const VertexBuffer& buffer, const Command& command)
+    {
+        assert( buffer.layout.format == VertexLayout::Float32 );
+
+        Bounds bounds;
+        auto pointAt = [&buffer, &command](size_t i) -> const fvec3& {
+            return buffer.vbo[buffer.index(command.index + i) + command.baseVertex].position;
+        };
+
+        for( size_t i = 0; i < command.count; ++i )
+        {
+            const fvec3& p = pointAt(i);
+            bounds.low = fvec3(std::min(bounds.low.x, p.x), std::min(bounds.low.y, p.y),
+                               std::min(bounds.low.z, p.z));
+            bounds.high = fvec3(std::max(bounds.high.x, p.x), std::max(bounds.high.y, p.y),
+                                std::max(bounds.high.z, p.z));
+        }
+
+        setSphere(bounds, command.count, pointAt);
+        return bounds;
+    }
+
+    void computeObjectBounds(IObject& object)
+    {
+        const auto& vertices = object.vertices;
+        object.bounds = computeBounds(vertices.data(), vertices.size());
+
+        // positions used by every mesh, in order of first use
+        std::vector<fvec3> points;
+        std::vector<uint32_t> usedBy(vertices.size(), 0);
+
+        for( uint32_t m = 0; m < object.meshes.size(); ++m )
+        {
+            Mesh& mesh = object.meshes[m];
+
+            points.clear();
+            for( const auto& face : mesh.faces )
+            {
+                for( const auto& index : face.indices )
+                {
+                    if( (index.vertexIndex > 0) && (size_t(index.vertexIndex) <= vertices.size()) &&
+                        (usedBy[index.vertexIndex - 1] != m + 1) )
+                    {
+                        usedBy[index.vertexIndex - 1] = m + 1;
+                        points.push_back(vertices[index.vertexIndex - 1]);
+                    }
+                }
+            }
+
+            mesh.bounds = computeBounds(points.data(), points.size());
+        }
+    }
+}
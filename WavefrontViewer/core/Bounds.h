@@ -0,0 +1,44 @@
+//
+//  Bounds.h
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#ifndef Bounds_h
+#define Bounds_h
+
+#include <cstddef>
+
+#include "IObject.h"
+
+namespace WavefrontFileReader
+{
+    /**
+     * Bounds of an array of points. The box is found with SIMD min/max on
+     * 4 points at a time, the sphere with a second pass for the radius.
+     *
+     * @param points - points to enclose
+     * @param count - number of points
+     */
+    Bounds computeBounds(const fvec3* points, size_t count);
+
+    /**
+     * Bounds of the vertices used by a command
+     *
+     * @param buffer - buffer with Float32 vertices
+     * @param command - command of the buffer
+     */
+    Bounds commandBounds(const VertexBuffer& buffer, const Command& command);
+
+    /**
+     * Compute the bounds of the object positions and of every mesh. Faces
+     * with relative indices don't count for the mesh bounds.
+     *
+     * @param object - object read from file
+     */
+    void computeObjectBounds(IObject& object);
+}
+
+#endif /* Bounds_h */
@@ -0,0 +1,572 @@
+//
+//  Bvh.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include "Bvh.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+#include "ThreadPool.h"
+
+namespace WavefrontFileReader
+{
+    namespace
+    {
+        /// Number of bins of every axis evaluated by the surface area heuristic
+        const unsigned kBins = 16;
+
+        /// Nodes with more triangles are always split
+        const uint32_t kMaxLeafSize = 8;
+
+        /// Cost of visiting a node, relative to the cost of a triangle test
+        const float kTraversalCost = 1.0f;
+
+        /// Subtrees with fewer triangles are built in the task of their parent
+        const uint32_t kParallelThreshold = 1 << 15;
+
+        /// Deeper nodes are split in the middle, so the traversal stack
+        /// never overflows
+        const unsigned kMaxSahDepth = 48;
+
+        /// Traversal stack size, more than the deepest tree
+        const unsigned kStackSize = 128;
+
+        inline float axis(const fvec3& v, unsigned i)
+        {
+            return (i == 0) ? v.x : ((i == 1) ? v.y : v.z);
+        }
+
+        inline fvec3 minimum(const fvec3& a, const fvec3& b)
+        {
+            return fvec3(std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z));
+        }
+
+        inline fvec3 maximum(const fvec3& a, const fvec3& b)
+        {
+            return fvec3(std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z));
+        }
+
+        /**
+         * Axis aligned box used while building
+         */
+        struct Box
+        {
+            fvec3 low = fvec3(INFINITY, INFINITY, INFINITY); /// smallest coordinates
+            fvec3 high = fvec3(-INFINITY, -INFINITY, -INFINITY); /// largest coordinates
+
+            void grow(const fvec3& point)
+            {
+                low = minimum(low, point);
+                high = maximum(high, point);
+            }
+
+            void grow(const Box& box)
+            {
+                low = minimum(low, box.low);
+                high = maximum(high, box.high);
+            }
+
+            /// Half of the surface area, 0 for empty boxes
+            float area() const
+            {
+                if( low.x > high.x )
+                {
+                    return 0.0f;
+                }
+
+                const fvec3 size = high - low;
+                return size.x * size.y + size.y * size.z + size.z * size.x;
+            }
+        };
+
+        /**
+         * Triangle bounds used while building
+         */
+        struct Primitive
+        {
+            Box box; /// triangle bounds
+            fvec3 centroid; /// box center
+        };
+
+        /**
+         * Node while building, the children are found with their numbers
+         */
+        struct BuildNode
+        {
+            Box box; /// bounds of the node triangles
+            uint32_t begin = 0; /// first triangle in the order
+            uint32_t end = 0; /// one past the last triangle
+            uint32_t left = 0; /// left child, 0 for leafs
+            uint32_t right = 0; /// right child
+        };
+
+        /**
+         * Top down binned SAH builder. The triangles of a node are a range of
+         * the order and the children split the range, so the subtrees work on
+         * different triangles. A subtree of n triangles uses at most 2n - 1
+         * nodes: the left child follows its parent and the right child starts
+         * after the nodes reserved by the left one. The numbers don't depend
+         * on the threads and the unused nodes are dropped at the end.
+         */
+        class Builder
+        {
+        public:
+            Builder(const std::vector<Primitive>& primitives, std::vector<uint32_t>& order,
+                    std::vector<BuildNode>& nodes)
+            : m_primitives(primitives), m_order(order), m_nodes(nodes) {}
+
+            /**
+             * Build the subtree of a node
+             * @param node - node number
+             * @param begin - first triangle in the order
+             * @param end - one past the last triangle
+             * @param depth - node depth, 0 for the root
+             * @param threads - number of threads that can build the subtree
+             */
+            void build(uint32_t node, uint32_t begin, uint32_t end, unsigned depth,
+                       unsigned threads)
+            {
+                Box box, centroids;
+                for( uint32_t i = begin; i < end; ++i )
+                {
+                    const Primitive& primitive = m_primitives[m_order[i]];
+                    box.grow(primitive.box);
+                    centroids.grow(primitive.centroid);
+                }
+
+                BuildNode& current = m_nodes[node];
+                current.box = box;
+                current.begin = begin;
+                current.end = end;
+
+                const uint32_t count = end - begin;
+                if( count == 1 )
+                {
+                    return;
+                }
+
+                uint32_t middle = begin;
+                if( depth < kMaxSahDepth )
+                {
+                    middle = splitWithSah(box, centroids, begin, end);
+                }
+                else if( count > kMaxLeafSize )
+                {
+                    middle = end;
+                }
+                if( middle == begin )
+                {
+                    // a leaf is cheaper
+                    return;
+                }
+
+                if( middle == end )
+                {
+                    // the centroids can't be separated or the tree is too
+                    // deep, split in the middle of the largest axis
+                    const fvec3 size = centroids.high - centroids.low;
+                    const unsigned largest = (size.x >= size.y) ? ((size.x >= size.z) ? 0 : 2)
+                                                                : ((size.y >= size.z) ? 1 : 2);
+                    middle = begin + count / 2;
+                    std::nth_element(m_order.begin() + begin, m_order.begin() + middle,
+                                     m_order.begin() + end,
+                                     [this, largest](uint32_t a, uint32_t b) {
+                        return axis(m_primitives[a].centroid, largest) <
+                               axis(m_primitives[b].centroid, largest);
+                    });
+                }
+
+                const uint32_t left = node + 1;
+                const uint32_t right = node + 2 * (middle - begin);
+                current.left = left;
+                current.right = right;
+
+                if( (threads > 1) && (count >= kParallelThreshold) )
+                {
+                    // the left subtree can be stolen by an idle worker
+                    TaskGroup group;
+                    group.run([=]() { build(left, begin, middle, depth + 1, threads / 2); });
+                    build(right, middle, end, depth + 1, threads - threads / 2);
+                    group.wait();
+                }
+                else
+                {
+                    build(left, begin, middle, depth + 1, threads);
+                    build(right, middle, end, depth + 1, threads);
+                }
+            }
+
+        private:
+            /**
+             * Find the cheapest split and partition the triangles
+             * @return Returns the first triangle of the right child, begin
+             *          when a leaf is cheaper and end when no split is found
+             */
+            uint32_t splitWithSah(const Box& box, const Box& centroids, uint32_t begin, uint32_t end)
+            {
+                const uint32_t count = end - begin;
+
+                // costs are multiplied by the node area
+                float bestCost = (count <= kMaxLeafSize) ? float(count) * box.area() : INFINITY;
+                int bestAxis = -1;
+                unsigned bestBin = 0;
+
+                for( unsigned a = 0; a < 3; ++a )
+                {
+                    const float low = axis(centroids.low, a);
+                    const float extent = axis(centroids.high, a) - low;
+                    if( !(extent > 0.0f) )
+                    {
+                        continue;
+                    }
+
+                    const float scale = kBins / extent;
+                    Box bins[kBins];
+                    uint32_t counts[kBins] = {};
+
+                    for( uint32_t i = begin; i < end; ++i )
+                    {
+                        const Primitive& primitive = m_primitives[m_order[i]];
+                        const unsigned bin = binOf(primitive.centroid, a, low, scale);
+                        bins[bin].grow(primitive.box);
+                        ++counts[bin];
+                    }
+
+                    // areas and counts on the right of every split
+                    float rightCosts[kBins];
+                    uint32_t rightCounts[kBins];
+                    Box right;
+                    uint32_t rightCount = 0;
+                    for( unsigned bin = kBins - 1; bin > 0; --bin )
+                    {
+                        right.grow(bins[bin]);
+                        rightCount += counts[bin];
+                        rightCosts[bin] = right.area() * float(rightCount);
+                        rightCounts[bin] = rightCount;
+                    }
+
+                    Box left;
+                    uint32_t leftCount = 0;
+                    for( unsigned bin = 1; bin < kBins; ++bin )
+                    {
+                        left.grow(bins[bin - 1]);
+                        leftCount += counts[bin - 1];
+                        if( (leftCount == 0) || (rightCounts[bin] == 0) )
+                        {
+                            continue;
+                        }
+
+                        const float cost = kTraversalCost * box.area() +
+                                           left.area() * float(leftCount) + rightCosts[bin];
+                        if( cost < bestCost )
+                        {
+                            bestCost = cost;
+                            bestAxis = int(a);
+                            bestBin = bin;
+                        }
+                    }
+                }
+
+                if( bestAxis < 0 )
+                {
+                    return (count <= kMaxLeafSize) ? begin : end;
+                }
+
+                const unsigned a = unsigned(bestAxis);
+                const float low = axis(centroids.low, a);
+                const float scale = kBins / (axis(centroids.high, a) - low);
+                const auto middle = std::partition(m_order.begin() + begin, m_order.begin() + end,
+                                                   [&](uint32_t i) {
+                    return binOf(m_primitives[i].centroid, a, low, scale) < bestBin;
+                });
+                return uint32_t(middle - m_order.begin());
+            }
+
+            static unsigned binOf(const fvec3& centroid, unsigned a, float low, float scale)
+            {
+                const int bin = int((axis(centroid, a) - low) * scale);
+                return unsigned(std::min(std::max(bin, 0), int(kBins) - 1));
+            }
+
+            const std::vector<Primitive>& m_primitives; /// bounds of all the triangles
+            std::vector<uint32_t>& m_order; /// triangles, every node owns a range
+            std::vector<BuildNode>& m_nodes; /// nodes, 2n - 1 for n triangles
+        };
+
+        /**
+         * Distance where a ray enters a box
+         * @param low - box smallest coordinates
+         * @param high - box largest coordinates
+         * @param origin - ray origin
+         * @param inverse - 1 / ray direction
+         * @param maxDistance - farthest distance checked
+         * @return Returns INFINITY when the box is missed or farther than maxDistance
+         */
+        inline float enterBox(const fvec3& low, const fvec3& high, const fvec3& origin,
+                              const fvec3& inverse, float maxDistance)
+        {
+            const float x0 = (low.x - origin.x) * inverse.x, x1 = (high.x - origin.x) * inverse.x;
+            const float y0 = (low.y - origin.y) * inverse.y, y1 = (high.y - origin.y) * inverse.y;
+            const float z0 = (low.z - origin.z) * inverse.z, z1 = (high.z - origin.z) * inverse.z;
+
+            const float enter = std::max(std::max(std::min(x0, x1), std::min(y0, y1)),
+                                         std::max(std::min(z0, z1), 0.0f));
+            const float exit = std::min(std::min(std::max(x0, x1), std::max(y0, y1)),
+                                        std::min(std::max(z0, z1), maxDistance));
+            return (enter <= exit) ? enter : INFINITY;
+        }
+    }
+
+    Bvh::Bvh(const IObject& object, unsigned threadCount)
+    {
+        if( threadCount == 0 )
+        {
+            threadCount = ThreadPool::shared().threadCount();
+        }
+
+        const auto& vertices = object.vertices;
+        auto position = [&vertices](const IndexData& index) -> const fvec3& {
+            return vertices[index.vertexIndex - 1];
+        };
+
+        // faces are split in a fan of triangles
+        std::vector<Triangle> triangles;
+        std::vector<Primitive> primitives;
+        for( uint32_t m = 0; m < object.meshes.size(); ++m )
+        {
+            uint32_t f = 0;
+            for( const auto& face : object.meshes[m].faces )
+            {
+                const auto& indices = face.indices;
+                bool valid = (indices.size() >= 3);
+                for( const auto& index : indices )
+                {
+                    valid &= (index.vertexIndex > 0) && (size_t(index.vertexIndex) <= vertices.size());
+                }
+
+                for( uint32_t k = 0; valid && (k + 2 < indices.size()); ++k )
+                {
+                    const fvec3& a = position(indices[0]);
+                    const fvec3& b = position(indices[k + 1]);
+                    const fvec3& c = position(indices[k + 2]);
+
+                    Triangle triangle;
+                    triangle.a = a;
+                    triangle.ab = b - a;
+                    triangle.ac = c - a;
+                    triangles.push_back(triangle);
+
+                    Primitive primitive;
+                    primitive.box.grow(a);
+                    primitive.box.grow(b);
+                    primitive.box.grow(c);
+                    primitive.centroid = (primitive.box.low + primitive.box.high) * 0.5f;
+                    primitives.push_back(primitive);
+
+                    Source source;
+                    source.mesh = m;
+                    source.face = f;
+                    source.triangle = k;
+                    m_sources.push_back(source);
+                }
+                ++f;
+            }
+        }
+
+        if( triangles.empty() )
+        {
+            return;
+        }
+
+        std::vector<uint32_t> order(triangles.size());
+        for( uint32_t i = 0; i < order.size(); ++i )
+        {
+            order[i] = i;
+        }
+
+        std::vector<BuildNode> buildNodes(2 * triangles.size() - 1);
+        Builder(primitives, order, buildNodes).build(0, 0, uint32_t(order.size()), 0, threadCount);
+
+        // depth first order without the unused nodes
+        m_nodes.reserve(buildNodes.size());
+        std::vector<std::pair<uint32_t, uint32_t>> stack(1, std::make_pair(0u, UINT32_MAX));
+        while( !stack.empty() )
+        {
+            const auto item = stack.back();
+            stack.pop_back();
+
+            const BuildNode& buildNode = buildNodes[item.first];
+            const uint32_t index = uint32_t(m_nodes.size());
+            if( item.second != UINT32_MAX )
+            {
+                m_nodes[item.second].first = index;
+            }
+
+            Node node;
+            node.low = buildNode.box.low;
+            node.high = buildNode.box.high;
+            if( buildNode.left == 0 )
+            {
+                node.first = buildNode.begin;
+                node.count = buildNode.end - buildNode.begin;
+            }
+            m_nodes.push_back(node);
+
+            if( buildNode.left != 0 )
+            {
+                // the left child is visited next
+                stack.push_back(std::make_pair(buildNode.right, index));
+                stack.push_back(std::make_pair(buildNode.left, UINT32_MAX));
+            }
+        }
+        m_nodes.shrink_to_fit();
+
+        // triangles in leaf order
+        m_triangles.resize(triangles.size());
+        std::vector<Source> sources(m_sources.size());
+        for( size_t i = 0; i < order.size(); ++i )
+        {
+            m_triangles[i] = triangles[order[i]];
+            sources[i] = m_sources[order[i]];
+        }
+        m_sources.swap(sources);
+    }
+
+    bool Bvh::intersect(const Ray& ray, RayHit& hit) const
+    {
+        if( m_nodes.empty() )
+        {
+            return false;
+        }
+
+        const fvec3& origin = ray.origin;
+        const fvec3& direction = ray.direction;
+        const fvec3 inverse(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+
+        float closest = ray.maxDistance;
+        uint32_t closestTriangle = UINT32_MAX;
+        float closestU = 0.0f, closestV = 0.0f;
+
+        // nodes left to visit with the distance where the ray enters them
+        std::pair<uint32_t, float> stack[kStackSize];
+        unsigned top = 0;
+
+        const float rootDistance = enterBox(m_nodes[0].low, m_nodes[0].high, origin, inverse,
+                                            closest);
+        if( rootDistance != INFINITY )
+        {
+            stack[top++] = std::make_pair(0u, rootDistance);
+        }
+
+        while( top > 0 )
+        {
+            const auto item = stack[--top];
+            if( item.second > closest )
+            {
+                continue;
+            }
+
+            const Node* node = &m_nodes[item.first];
+            while( node->count == 0 )
+            {
+                const uint32_t left = uint32_t(node - m_nodes.data()) + 1;
+                const uint32_t right = node->first;
+                const float leftDistance = enterBox(m_nodes[left].low, m_nodes[left].high,
+                                                    origin, inverse, closest);
+                const float rightDistance = enterBox(m_nodes[right].low, m_nodes[right].high,
+                                                     origin, inverse, closest);
+
+                if( (leftDistance == INFINITY) && (rightDistance == INFINITY) )
+                {
+                    node = nullptr;
+                    break;
+                }
+
+                // the nearest child first, the other one later
+                uint32_t next = (leftDistance <= rightDistance) ? left : right;
+                if( (leftDistance != INFINITY) && (rightDistance != INFINITY) )
+                {
+                    assert( top < kStackSize );
+                    stack[top++] = (next == left) ? std::make_pair(right, rightDistance)
+                                                  : std::make_pair(left, leftDistance);
+                }
+                node = &m_nodes[next];
+            }
+
+            if( node == nullptr )
+            {
+                continue;
+            }
+
+            // Moller-Trumbore
+            for( uint32_t i = node->first; i < node->first + node->count; ++i )
+            {
+                const Triangle& triangle = m_triangles[i];
+                const fvec3 p = cross(direction, triangle.ac);
+                const float determinant = dot(triangle.ab, p);
+                if( determinant == 0.0f )
+                {
+                    continue;
+                }
+
+                const float inverseDeterminant = 1.0f / determinant;
+                const fvec3 s = origin - triangle.a;
+                const float u = dot(s, p) * inverseDeterminant;
+                if( (u < 0.0f) || (u > 1.0f) )
+                {
+                    continue;
+                }
+
+                const fvec3 q = cross(s, triangle.ab);
+                const float v = dot(direction, q) * inverseDeterminant;
+                if( (v < 0.0f) || (u + v > 1.0f) )
+                {
+                    continue;
+                }
+
+                const float distance = dot(triangle.ac, q) * inverseDeterminant;
+                if( (distance >= 0.0f) && (distance < closest) )
+                {
+                    closest = distance;
+                    closestTriangle = i;
+                    closestU = u;
+                    closestV = v;
+                }
+            }
+        }
+
+        if( closestTriangle == UINT32_MAX )
+        {
+            return false;
+        }
+
+        const Source& source = m_sources[closestTriangle];
+        hit.mesh = source.mesh;
+        hit.face = source.face;
+        hit.triangle = source.triangle;
+        hit.distance = closest;
+        hit.u = closestU;
+        hit.v = closestV;
+        return true;
+    }
+
+    Bounds Bvh::bounds() const
+    {
+        Bounds bounds;
+        if( !m_nodes.empty() )
+        {
+            bounds.low = m_nodes[0].low;
+            bounds.high = m_nodes[0].high;
+            bounds.center = (bounds.low + bounds.high) * 0.5f;
+            bounds.radius = length(bounds.high - bounds.low) * 0.5f;
+        }
+        return bounds;
+    }
+}
@@ -0,0 +1,124 @@
+//
+//  Bvh.h
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#ifndef Bvh_h
+#define Bvh_h
+
+#include <vector>
+#include <cstddef>
+
+#include "IObject.h"
+
+namespace WavefrontFileReader
+{
+    /**
+     * Half line starting from origin
+     */
+    struct Ray
+    {
+        fvec3 origin; /// start point
+        fvec3 direction; /// direction, doesn't need length 1
+        float maxDistance = INFINITY; /// hits farther than this are ignored, in direction units
+
+        Ray() {}
+        Ray(const fvec3& o, const fvec3& d) : origin(o), direction(d) {}
+    };
+
+    /**
+     * Closest triangle hit by a @see Ray
+     */
+    struct RayHit
+    {
+        uint32_t mesh = 0; /// mesh number in IObject::meshes
+        uint32_t face = 0; /// face number in the mesh
+        /// triangle of the face, the faces are split in a fan. Triangle k
+        /// has the face corners 0, k + 1 and k + 2
+        uint32_t triangle = 0;
+        float distance = INFINITY; /// origin + direction * distance is the hit point
+        float u = 0.0f; /// barycentric coordinate of the corner k + 1
+        float v = 0.0f; /// barycentric coordinate of the corner k + 2
+    };
+
+    /**
+     * Bounding volume hierarchy over the faces of an object, for ray
+     * queries. Faces are split in triangles, faces with relative indices are
+     * skipped.
+     *
+     * The tree is built top down with the surface area heuristic evaluated
+     * on 16 bins of every axis. Subtrees with many triangles are built on
+     * their own thread and the result doesn't depend on the number of
+     * threads. The nodes are stored in depth first order, the left child of a
+     * node follows it.
+     */
+    class Bvh
+    {
+    public:
+        /**
+         * Build the hierarchy
+         * @param object - object with meshes, it is not used after the build
+         * @param threadCount - maximum number of threads, 0 for the threads of
+         *              the shared @see ThreadPool
+         */
+        explicit Bvh(const IObject& object, unsigned threadCount = 0);
+
+        /**
+         * Find the closest triangle hit by a ray
+         * @param ray - ray to trace
+         * @param hit - receives the hit when there is one
+         * @return Returns true when a triangle is hit
+         */
+        bool intersect(const Ray& ray, RayHit& hit) const;
+
+        /// Number of triangles
+        size_t trianglesCount() const { return m_triangles.size(); }
+
+        /// Number of nodes, leafs included
+        size_t nodesCount() const { return m_nodes.size(); }
+
+        /// Bounds of all the triangles
+        Bounds bounds() const;
+
+    private:
+        /**
+         * Node of the tree, 32 bytes
+         */
+        struct Node
+        {
+            fvec3 low; /// smallest coordinates of the node triangles
+            uint32_t first = 0; /// first triangle of a leaf, right child of an inner node
+            fvec3 high; /// largest coordinates of the node triangles
+            uint32_t count = 0; /// number of triangles of a leaf, 0 for inner nodes
+        };
+
+        /**
+         * Triangle prepared for the intersection test
+         */
+        struct Triangle
+        {
+            fvec3 a; /// first corner
+            fvec3 ab; /// second corner - first corner
+            fvec3 ac; /// third corner - first corner
+        };
+
+        /**
+         * Face triangle of a @see Triangle
+         */
+        struct Source
+        {
+            uint32_t mesh; /// mesh number
+            uint32_t face; /// face number in the mesh
+            uint32_t triangle; /// triangle number in the face
+        };
+
+        std::vector<Node> m_nodes; /// tree nodes, the root first
+        std::vector<Triangle> m_triangles; /// triangles in leaf order
+        std::vector<Source> m_sources; /// face of every triangle
+    };
+}
+
+#endif /* Bvh_h */
@@ -0,0 +1,149 @@
+//
+//  Frustum.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include "Frustum.h"
+
+#include <algorithm>
+#include <cassert>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace WavefrontFileReader
+{
+    Frustum::Frustum()
+    {
+        for( size_t i = 0; i < 6; ++i )
+        {
+            setPlane(i, fvec3(), 0.0f);
+        }
+    }
+
+    Frustum::Frustum(const float matrix[16])
+    {
+        // rows of the matrix, a point is inside when -w <= x, y, z <= w
+        auto row = [matrix](size_t i, float sign) -> fvec3 {
+            return fvec3(matrix[3] + sign * matrix[i], matrix[7] + sign * matrix[4 + i],
+                         matrix[11] + sign * matrix[8 + i]);
+        };
+        auto distance = [matrix](size_t i, float sign) -> float {
+            return matrix[15] + sign * matrix[12 + i];
+        };
+
+        for( size_t i = 0; i < 3; ++i )
+        {
+            setPlane(2 * i, row(i, 1.0f), distance(i, 1.0f));
+            setPlane(2 * i + 1, row(i, -1.0f), distance(i, -1.0f));
+        }
+    }
+
+    void Frustum::setPlane(size_t i, const fvec3& normal, float distance)
+    {
+        assert( i < 6 );
+
+        m_x[i] = normal.x;
+        m_y[i] = normal.y;
+        m_z[i] = normal.z;
+        m_w[i] = distance;
+
+        if( i == 0 )
+        {
+            m_x[6] = m_x[7] = normal.x;
+            m_y[6] = m_y[7] = normal.y;
+            m_z[6] = m_z[7] = normal.z;
+            m_w[6] = m_w[7] = distance;
+        }
+    }
+
+    bool Frustum::intersects(const Bounds& bounds) const
+    {
+        if( bounds.empty() )
+        {
+            return false;
+        }
+
+        // the box corner farthest inside a plane has, for every axis, the
+        // coordinate with the largest product with the normal. The box is
+        // outside when that corner is outside one of the planes
+#if defined(__SSE2__)
+        const __m128 lowX = _mm_set1_ps(bounds.low.x), highX = _mm_set1_ps(bounds.high.x);
+        const __m128 lowY = _mm_set1_ps(bounds.low.y), highY = _mm_set1_ps(bounds.high.y);
+        const __m128 lowZ = _mm_set1_ps(bounds.low.z), highZ = _mm_set1_ps(bounds.high.z);
+
+        for( size_t i = 0; i < 8; i += 4 )
+        {
+            const __m128 x = _mm_load_ps(m_x + i);
+            const __m128 y = _mm_load_ps(m_y + i);
+            const __m128 z = _mm_load_ps(m_z + i);
+
+            __m128 d = _mm_load_ps(m_w + i);
+            d = _mm_add_ps(d, _mm_max_ps(_mm_mul_ps(x, lowX), _mm_mul_ps(x, highX)));
+            d = _mm_add_ps(d, _mm_max_ps(_mm_mul_ps(y, lowY), _mm_mul_ps(y, highY)));
+            d = _mm_add_ps(d, _mm_max_ps(_mm_mul_ps(z, lowZ), _mm_mul_ps(z, highZ)));
+
+            if( _mm_movemask_ps(_mm_cmplt_ps(d, _mm_setzero_ps())) != 0 )
+            {
+                return false;
+            }
+        }
+        return true;
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+        const float32x4_t lowX = vdupq_n_f32(bounds.low.x), highX = vdupq_n_f32(bounds.high.x);
+        const float32x4_t lowY = vdupq_n_f32(bounds.low.y), highY = vdupq_n_f32(bounds.high.y);
+        const float32x4_t lowZ = vdupq_n_f32(bounds.low.z), highZ = vdupq_n_f32(bounds.high.z);
+
+        for( size_t i = 0; i < 8; i += 4 )
+        {
+            const float32x4_t x = vld1q_f32(m_x + i);
+            const float32x4_t y = vld1q_f32(m_y + i);
+            const float32x4_t z = vld1q_f32(m_z + i);
+
+            float32x4_t d = vld1q_f32(m_w + i);
+            d = vaddq_f32(d, vmaxq_f32(vmulq_f32(x, lowX), vmulq_f32(x, highX)));
+            d = vaddq_f32(d, vmaxq_f32(vmulq_f32(y, lowY), vmulq_f32(y, highY)));
+            d = vaddq_f32(d, vmaxq_f32(vmulq_f32(z, lowZ), vmulq_f32(z, highZ)));
+
+            if( vmaxvq_u32(vcltq_f32(d, vdupq_n_f32(0.0f))) != 0 )
+            {
+                return false;
+            }
+        }
+        return true;
+#else
+        for( size_t i = 0; i < 6; ++i )
+        {
+            const float d = m_w[i] +
+                std::max(m_x[i] * bounds.low.x, m_x[i] * bounds.high.x) +
+                std::max(m_y[i] * bounds.low.y, m_y[i] * bounds.high.y) +
+                std::max(m_z[i] * bounds.low.z, m_z[i] * bounds.high.z);
+            if( d < 0.0f )
+            {
+                return false;
+            }
+        }
+        return true;
+#endif
+    }
+
+    size_t cullCommands(const std::vector<Command>& commands, const Frustum& frustum,
+                        std::vector<uint32_t>& visible)
+    {
+        visible.clear();
+        for( uint32_t i = 0; i < commands.size(); ++i )
+        {
+            if( frustum.intersects(commands[i].bounds) )
+            {
+                visible.push_back(i);
+            }
+        }
+        return commands.size() - visible.size();
+    }
+}
@@ -0,0 +1,70 @@
+//
+//  Frustum.h
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#ifndef Frustum_h
+#define Frustum_h
+
+#include <vector>
+#include <cstddef>
+
+#include "types.h"
+
+namespace WavefrontFileReader
+{
+    /**
+     * View frustum, the space between 6 planes. The planes are stored as
+     * structure of arrays so a box is tested against 4 planes at a time.
+     */
+    class Frustum
+    {
+    public:
+        /// Frustum that contains everything
+        Frustum();
+
+        /**
+         * Frustum of a model view projection matrix, in model coordinates
+         * @param matrix - column major 4x4 matrix, as OpenGL and GLKit store it
+         */
+        explicit Frustum(const float matrix[16]);
+
+        /**
+         * Set a plane. Points inside have dot(normal, point) + distance >= 0
+         * @param i - plane number, from 0 to 5
+         * @param normal - plane normal, towards the inside
+         * @param distance - plane distance
+         */
+        void setPlane(size_t i, const fvec3& normal, float distance);
+
+        /**
+         * Check if a box may be visible. The test is conservative, boxes
+         * outside the frustum near its corners are still visible.
+         * @param bounds - box to test, empty boxes are never visible
+         */
+        bool intersects(const Bounds& bounds) const;
+
+    private:
+        /// Planes x * x + y * y + z * z + w, two batches of 4. The last two
+        /// repeat the first plane
+        alignas(16) float m_x[8];
+        alignas(16) float m_y[8];
+        alignas(16) float m_z[8];
+        alignas(16) float m_w[8];
+    };
+
+    /**
+     * Find the commands that may be visible
+     * @param commands - commands with their bounds
+     * @param frustum - view frustum
+     * @param visible - receives the number of every visible command
+     * @return Returns the number of culled commands
+     */
+    size_t cullCommands(const std::vector<Command>& commands, const Frustum& frustum,
+                        std::vector<uint32_t>& visible);
+}
+
+#endif /* Frustum_h */
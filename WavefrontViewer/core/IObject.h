@@ -13,29 +13,308 @@
 #include <vector>
 #include <cinttypes>
 #include <string>
+#include <cstddef>
+
+#include "types.h"
+
+/**
+ * Format of the vertices from a @see VertexBuffer
+ */
+struct VertexLayout
+{
+    /// Available vertex formats
+    enum Format
+    {
+        Float32,      /// @see Vertex, 36 bytes
+        Normalized16, /// 16 bits positions and texture coordinates normalized to
+                      /// their bounds, octahedral normals. 16 bytes
+        HalfFloat     /// half float positions relative to the bounds center and
+                      /// texture coordinates, octahedral normals. 16 bytes
+    };
+
+    /// Storage of an attribute component
+    enum ComponentType
+    {
+        Float,
+        Half,
+        UnsignedShort,
+        Short
+    };
+
+    /**
+     * Position of an attribute inside a vertex
+     */
+    struct Attribute
+    {
+        ComponentType type = Float; /// type of every component
+        uint32_t components = 3; /// number of components
+        bool normalized = false; /// integers are mapped to [0, 1] or [-1, 1]
+        uint32_t offset = 0; /// bytes from the vertex start
+
+        Attribute() {}
+        Attribute(ComponentType t, uint32_t c, bool n, uint32_t o)
+        : type(t), components(c), normalized(n), offset(o) {}
+    };
+
+    Format format = Float32;
+    uint32_t stride = sizeof(Vertex); /// bytes between two vertices
+    Attribute position = Attribute(Float, 3, false, offsetof(Vertex, position));
+    Attribute normal = Attribute(Float, 3, false, offsetof(Vertex, normal));
+    Attribute texture = Attribute(Float, 3, false, offsetof(Vertex, texture));
+
+    /// Normals are stored as the two octahedral coordinates
+    bool octahedralNormals = false;
+
+    /// position = positionOffset + stored position * positionScale
+    fvec3 positionOffset;
+    fvec3 positionScale = fvec3(1.0f, 1.0f, 1.0f);
+
+    /// texture = textureOffset + stored texture * textureScale
+    fvec3 textureOffset;
+    fvec3 textureScale = fvec3(1.0f, 1.0f, 1.0f);
+};
+
+/**
+ * Simplified version of the commands of a @see VertexBuffer. Uses the same
+ * vertices, its indices are stored after the indices of the full detail.
+ */
+struct LodLevel
+{
+    float ratio = 1.0f; /// fraction of the triangles that were kept
+    float error = 0.0f; /// distance to the full detail surface, in model units
+    std::vector<Command> commands; /// same commands as the full detail
+};
 
 struct VertexBuffer
 {
-    std::vector<Vertex> vbo;
-    std::vector<uint32_t> ibo;
+    std::vector<Vertex> vbo; /// vertices when the layout format is Float32
+    std::vector<uint8_t> packedVbo; /// vertices in the other layout formats
+    VertexLayout layout; /// format of the vertices
+    std::vector<uint32_t> ibo; /// indices when indexSize is 4
+    std::vector<uint16_t> ibo16; /// indices when indexSize is 2
+    unsigned indexSize = 4; /// bytes used by an index
     float scale = 1.0;
     std::vector<Command> commands;
+    std::vector<Meshlet> meshlets; /// optional split of the commands, @see buildMeshlets
+    std::vector<LodLevel> lods; /// levels of detail, coarser ones last, @see generateLods
+    
+    bool empty() const
+    { return vbo.empty() && packedVbo.empty() && ibo.empty() && ibo16.empty(); }
+    
+    /// Number of vertices, whatever their format
+    size_t verticesCount() const
+    {
+        return (layout.format == VertexLayout::Float32) ? vbo.size()
+                                                        : packedVbo.size() / layout.stride;
+    }
+    
+    /// Number of indices, whatever their size
+    size_t indicesCount() const { return (indexSize == 2) ? ibo16.size() : ibo.size(); }
     
-    bool empty() const { return vbo.empty() && ibo.empty(); }
+    /// Index i of the buffer, without the base vertex of its command
+    uint32_t index(size_t i) const { return (indexSize == 2) ? ibo16[i] : ibo[i]; }
     
-    void clear() { return vbo.clear(); ibo.clear(); }
+    void clear()
+    {
+        vbo.clear();
+        packedVbo.clear();
+        layout = VertexLayout();
+        ibo.clear();
+        ibo16.clear();
+        indexSize = 4;
+        scale = 1.0;
+        commands.clear();
+        meshlets.clear();
+        lods.clear();
+    }
 };
 
+/**
+ * Options used to build a @see VertexBuffer
+ */
+struct VertexBufferOptions
+{
+    /// How the face corners that share a vertex are found
+    enum Welding
+    {
+        Hash, /// hash table lookup for every corner
+        Sort  /// radix sort of all the corners, faster for huge meshes
+    };
+
+    bool splitInTriangles = true; /// split quads and polygons in triangles
+    Welding welding = Hash; /// the vertex buffer is the same for all the methods
+
+    /// Build the meshes on the shared thread pool. Meshes don't share
+    /// vertices and the buffer is the same for any number of threads
+    bool parallel = false;
+    unsigned threadCount = 0; /// maximum number of threads, 0 for the pool threads
+
+    /// Fraction of the triangles kept by every level of detail, for example
+    /// { 0.5, 0.25, 0.1 }. No levels are generated when empty
+    std::vector<float> lodRatios;
+
+    /// Reorder the triangles for the post transform vertex cache
+    bool optimizeVertexCache = false;
+    /// Draw first the triangles that are likely to hide the others
+    bool optimizeOverdraw = false;
+    /// Move the vertices in the order they are used by the indices
+    bool optimizeVertexFetch = false;
+
+    /// Store 16 bits indices when every command uses less than 65536 vertices
+    bool shortIndices = false;
+    /// Split the commands that use too many vertices for 16 bits indices
+    bool splitCommands = false;
+
+    /// Format of the vertices. Packed formats don't keep the Float32 vertices
+    VertexLayout::Format vertexFormat = VertexLayout::Float32;
+
+    /// Split the Triangles commands in meshlets
+    bool meshlets = false;
+};
+
+/**
+ * Face from a @see FaceList. Points inside the list storage.
+ */
 struct Face
 {
-    std::vector<IndexData> indices;
+    ArrayView<IndexData> indices; /// indices of the face corners
+};
+
+/**
+ * Faces stored in compressed sparse row format: the indices of all the faces
+ * are kept in a single array and every face keeps only the offset of its
+ * first index. A mesh needs two allocations instead of one for every face.
+ */
+class FaceList
+{
+public:
+    /**
+     * Iterates faces. Faces are returned by value, they are only views
+     */
+    class const_iterator
+    {
+    public:
+        const_iterator(const FaceList& list, size_t index)
+        : m_list(&list), m_index(index) {}
+
+        Face operator* () const { return (*m_list)[m_index]; }
+        const_iterator& operator++ () { ++m_index; return *this; }
+        bool operator== (const const_iterator& other) const { return m_index == other.m_index; }
+        bool operator!= (const const_iterator& other) const { return m_index != other.m_index; }
+
+    private:
+        const FaceList* m_list; /// iterated list
+        size_t m_index; /// current face
+    };
+
+    /// Number of faces
+    size_t size() const { return m_offsets.size() - 1; }
+    bool empty() const { return m_offsets.size() == 1; }
+
+    Face operator[] (size_t i) const
+    {
+        Face face;
+        face.indices = ArrayView<IndexData>(m_indices.data() + m_offsets[i],
+                                            m_indices.data() + m_offsets[i+1]);
+        return face;
+    }
+
+    Face front() const { return (*this)[0]; }
+    Face back() const { return (*this)[size() - 1]; }
+
+    const_iterator begin() const { return const_iterator(*this, 0); }
+    const_iterator end() const { return const_iterator(*this, size()); }
+
+    /**
+     * Reserve memory
+     * @param facesCount - expected number of faces
+     * @param indicesCount - expected number of indices from all the faces
+     */
+    void reserve(size_t facesCount, size_t indicesCount)
+    {
+        m_offsets.reserve(facesCount + 1);
+        m_indices.reserve(indicesCount);
+    }
+
+    /**
+     * Add an index to the face that is built. @see finishFace must be called
+     * after the last index of the face
+     */
+    void addIndex(const IndexData& index) { m_indices.push_back(index); }
+
+    /**
+     * Close the face built with @see addIndex
+     * @return number of indices in face
+     */
+    size_t finishFace()
+    {
+        m_offsets.push_back(uint32_t(m_indices.size()));
+        return m_offsets.back() - m_offsets[m_offsets.size() - 2];
+    }
+
+    /// Remove all the faces, the memory is kept
+    void clear()
+    {
+        m_indices.clear();
+        m_offsets.resize(1);
+    }
+
+    /**
+     * Add all the faces from other list at the end of this list
+     */
+    void append(const FaceList& other)
+    {
+        const uint32_t base = uint32_t(m_indices.size());
+
+        m_indices.insert(m_indices.end(), other.m_indices.begin(), other.m_indices.end());
+
+        m_offsets.reserve(m_offsets.size() + other.size());
+        for( size_t i = 1; i < other.m_offsets.size(); ++i )
+        {
+            m_offsets.push_back(base + other.m_offsets[i]);
+        }
+    }
+
+    /**
+     * Replace all the faces
+     * @param indices - indices of all the faces
+     * @param offsets - offset of the first index of every face, followed by
+     *              the indices count, as returned by @see offsets
+     */
+    void assign(ArrayView<IndexData> indices, ArrayView<uint32_t> offsets)
+    {
+        m_indices.assign(indices.begin(), indices.end());
+        m_offsets.assign(offsets.begin(), offsets.end());
+        if( m_offsets.empty() )
+        {
+            m_offsets.push_back(0);
+        }
+    }
+
+    /// Indices of all faces, in face order
+    const std::vector<IndexData>& indices() const { return m_indices; }
+
+    /// Offset of the first index of every face, followed by the total indices count
+    const std::vector<uint32_t>& offsets() const { return m_offsets; }
+
+    /// Number of bytes allocated for faces
+    size_t memoryUsage() const
+    {
+        return m_indices.capacity() * sizeof(IndexData) +
+               m_offsets.capacity() * sizeof(uint32_t);
+    }
+
+private:
+    std::vector<IndexData> m_indices; /// indices of all faces
+    std::vector<uint32_t> m_offsets = std::vector<uint32_t>(1, 0); /// face start offsets
 };
 
 struct Mesh
 {
     std::string name; /// Mesh name if exist in file
-    std::vector<Face> faces; /// List with all the faces that describe the mesh
+    FaceList faces; /// List with all the faces that describe the mesh
     int numberOfElementsInFace = 0; /// number of index groups in a face
+    Bounds bounds; /// bounds of the vertices used by the faces
 };
 
 class IObject
@@ -44,6 +323,12 @@ public:
     virtual ~IObject() {}
     
     virtual const VertexBuffer& vertexBuffer() const = 0;
+    
+    /**
+     * Vertex buffer built with options. Safe to call from several threads,
+     * the buffer is built once for the options
+     */
+    virtual const VertexBuffer& vertexBuffer(const VertexBufferOptions& options) const = 0;
     virtual bool empty() const = 0;
     
     /// List with all the positions from file
@@ -57,6 +342,9 @@ public:
     
     /// List with all the meshes from file
     std::vector<Mesh> meshes;
+    
+    /// Bounds of all the positions from file
+    Bounds bounds;
 };
 
 
@@ -0,0 +1,243 @@
+//
+//  LineScanner.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include "LineScanner.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace WavefrontFileReader
+{
+    namespace
+    {
+        /**
+         * Classify 64 characters.
+         * @param data - 64 readable characters
+         * @param newLines - receives a bit for every '\n'
+         * @param delimiters - receives a bit for every white space, '\n' and '#'
+         * @param comments - receives a bit for every '#'
+         */
+        inline void classify(const char* data, uint64_t& newLines,
+                             uint64_t& delimiters, uint64_t& comments)
+        {
+#if defined(__AVX2__)
+            newLines = delimiters = comments = 0;
+            for( int i = 0; i < 2; ++i )
+            {
+                const __m256i v = _mm256_loadu_si256((const __m256i*)(data + 32 * i));
+
+                const __m256i newLine = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'));
+                const __m256i comment = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('#'));
+                const __m256i space = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')),
+                                    _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'))),
+                    _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r')));
+                const __m256i delimiter = _mm256_or_si256(space,
+                                                          _mm256_or_si256(newLine, comment));
+
+                const int shift = 32 * i;
+                newLines |= uint64_t(uint32_t(_mm256_movemask_epi8(newLine))) << shift;
+                comments |= uint64_t(uint32_t(_mm256_movemask_epi8(comment))) << shift;
+                delimiters |= uint64_t(uint32_t(_mm256_movemask_epi8(delimiter))) << shift;
+            }
+#elif defined(__SSE2__)
+            newLines = delimiters = comments = 0;
+            for( int i = 0; i < 4; ++i )
+            {
+                const __m128i v = _mm_loadu_si128((const __m128i*)(data + 16 * i));
+
+                const __m128i newLine = _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'));
+                const __m128i comment = _mm_cmpeq_epi8(v, _mm_set1_epi8('#'));
+                const __m128i space = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+                                 _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+                    _mm_cmpeq_epi8(v, _mm_set1_epi8('\r')));
+                const __m128i delimiter = _mm_or_si128(space,
+                                                       _mm_or_si128(newLine, comment));
+
+                const int shift = 16 * i;
+                newLines |= uint64_t(uint32_t(_mm_movemask_epi8(newLine))) << shift;
+                comments |= uint64_t(uint32_t(_mm_movemask_epi8(comment))) << shift;
+                delimiters |= uint64_t(uint32_t(_mm_movemask_epi8(delimiter))) << shift;
+            }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+            // NEON has no movemask, the bytes are reduced with pairwise adds
+            const uint8x16_t bits = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+                                      0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 };
+
+            auto toMask = [&bits](const uint8x16_t m[4]) -> uint64_t {
+                uint8x16_t sum0 = vpaddq_u8(vandq_u8(m[0], bits), vandq_u8(m[1], bits));
+                uint8x16_t sum1 = vpaddq_u8(vandq_u8(m[2], bits), vandq_u8(m[3], bits));
+                sum0 = vpaddq_u8(sum0, sum1);
+                sum0 = vpaddq_u8(sum0, sum0);
+                return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+            };
+
+            uint8x16_t newLine[4], comment[4], delimiter[4];
+            for( int i = 0; i < 4; ++i )
+            {
+                const uint8x16_t v = vld1q_u8((const uint8_t*)(data + 16 * i));
+
+                newLine[i] = vceqq_u8(v, vdupq_n_u8('\n'));
+                comment[i] = vceqq_u8(v, vdupq_n_u8('#'));
+                const uint8x16_t space = vorrq_u8(vorrq_u8(vceqq_u8(v, vdupq_n_u8(' ')),
+                                                           vceqq_u8(v, vdupq_n_u8('\t'))),
+                                                  vceqq_u8(v, vdupq_n_u8('\r')));
+                delimiter[i] = vorrq_u8(space, vorrq_u8(newLine[i], comment[i]));
+            }
+
+            newLines = toMask(newLine);
+            comments = toMask(comment);
+            delimiters = toMask(delimiter);
+#else
+            newLines = delimiters = comments = 0;
+            for( int i = 0; i < 64; ++i )
+            {
+                const char c = data[i];
+                const uint64_t bit = uint64_t(1) << i;
+
+                newLines |= (c == '\n') ? bit : 0;
+                comments |= (c == '#') ? bit : 0;
+                delimiters |= ((c == ' ') || (c == '\t') || (c == '\r') ||
+                               (c == '\n') || (c == '#')) ? bit : 0;
+            }
+#endif
+        }
+
+        /// Index of the lowest bit set. mask must not be 0
+        inline size_t lowestBit(uint64_t mask)
+        {
+            return size_t(__builtin_ctzll(mask));
+        }
+    }
+
+    LineScanner::LineScanner(const char* begin, const char* end)
+    : m_end(end), m_block(begin)
+    {
+        if( begin < end )
+        {
+            classifyBlock();
+        }
+    }
+
+    void LineScanner::classifyBlock()
+    {
+        const char* data = m_block;
+
+        // the last block is copied so the buffer is never read past its end.
+        // Padding with spaces ends any token that reaches the buffer end
+        char padded[kBlockSize];
+        const size_t available = size_t(m_end - m_block);
+        if( available < kBlockSize )
+        {
+            memset(padded, ' ', kBlockSize);
+            memcpy(padded, m_block, available);
+            data = padded;
+        }
+
+        classify(data, m_newLines, m_delimiters, m_comments);
+    }
+
+    bool LineScanner::nextBlock()
+    {
+        if( size_t(m_end - m_block) <= kBlockSize )
+        {
+            m_block = m_end;
+            m_offset = 0;
+            return false;
+        }
+
+        m_block += kBlockSize;
+        m_offset = 0;
+        classifyBlock();
+        return true;
+    }
+
+    bool LineScanner::nextLine(std::vector<Token>& tokens)
+    {
+        tokens.clear();
+
+        if( position() >= m_end )
+        {
+            return false;
+        }
+
+        const char* tokenBegin = nullptr;
+        bool comment = false;
+
+        for( ;; )
+        {
+            // bits that were not processed yet
+            const uint64_t remaining = (m_offset < kBlockSize) ? (~uint64_t(0) << m_offset) : 0;
+
+            if( comment )
+            {
+                // ignore everything till the end of line
+                const uint64_t newLines = m_newLines & remaining;
+                if( newLines != 0 )
+                {
+                    m_offset = lowestBit(newLines) + 1;
+                    return true;
+                }
+            }
+            else if( tokenBegin != nullptr )
+            {
+                // look for the token end
+                const uint64_t delimiters = m_delimiters & remaining;
+                if( delimiters != 0 )
+                {
+                    m_offset = lowestBit(delimiters);
+                    tokens.push_back(Token(tokenBegin, m_block + m_offset));
+                    tokenBegin = nullptr;
+                    continue;
+                }
+            }
+            else
+            {
+                // look for a token start, line end or comment
+                const uint64_t candidates = (~m_delimiters | m_newLines | m_comments) & remaining;
+                if( candidates != 0 )
+                {
+                    const size_t position = lowestBit(candidates);
+                    const uint64_t bit = uint64_t(1) << position;
+                    m_offset = position + 1;
+
+                    if( m_newLines & bit )
+                    {
+                        return true;
+                    }
+
+                    if( m_comments & bit )
+                    {
+                        comment = true;
+                    }
+                    else
+                    {
+                        tokenBegin = m_block + position;
+                    }
+                    continue;
+                }
+            }
+
+            if( !nextBlock() )
+            {
+                // the end of the buffer ends the last line
+                if( tokenBegin != nullptr )
+                {
+                    tokens.push_back(Token(tokenBegin, m_end));
+                }
+                return true;
+            }
+        }
+    }
+}
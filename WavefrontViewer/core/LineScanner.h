@@ -0,0 +1,91 @@
+//
+//  LineScanner.h
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#ifndef LineScanner_h
+#define LineScanner_h
+
+#include <vector>
+#include <cinttypes>
+#include <cstring>
+#include <cstddef>
+
+namespace WavefrontFileReader
+{
+    /**
+     * Characters range that points directly inside the parsed buffer.
+     * Used to avoid copying every token in a new string.
+     */
+    struct Token
+    {
+        const char* begin = nullptr; /// first character of the token
+        const char* end = nullptr; /// one past the last character
+
+        Token() {}
+        Token(const char* b, const char* e) : begin(b), end(e) {}
+
+        size_t size() const { return size_t(end - begin); }
+
+        bool operator== (const char* str) const
+        {
+            const size_t length = strlen(str);
+            return (size() == length) && (memcmp(begin, str, length) == 0);
+        }
+    };
+
+    /**
+     * Splits a buffer in lines and every line in tokens separated by white
+     * spaces. Everything after a '#' character till the end of the line is
+     * a comment and ignored.
+     *
+     * The buffer is classified 64 bytes at a time using SSE2, AVX2 or NEON
+     * when available: every block gives a bit mask for new lines, white
+     * spaces and comments, and tokens are extracted by walking the bits.
+     */
+    class LineScanner
+    {
+    public:
+        /// Size of the blocks classified at once
+        static const size_t kBlockSize = 64;
+
+        /**
+         * @param begin - first character of the buffer
+         * @param end - one past the last character. The buffer doesn't need
+         *              to be null terminated and is never read past end
+         */
+        LineScanner(const char* begin, const char* end);
+
+        /**
+         * Tokenize the next line
+         * @param tokens - vector with tokens. Vector will be cleared before
+         *              adding new tokens. Empty for blank or comment lines
+         * @return Returns false when there are no more lines
+         */
+        bool nextLine(std::vector<Token>& tokens);
+
+        /// First character that was not scanned yet
+        const char* position() const { return m_block + m_offset; }
+
+    private:
+        /// Compute the bit masks for the block starting at m_block
+        void classifyBlock();
+
+        /// Move to the next block. Returns false at the end of the buffer
+        bool nextBlock();
+
+    private:
+        const char* m_end = nullptr; /// end of the buffer
+        const char* m_block = nullptr; /// first character of current block
+        size_t m_offset = 0; /// first bit not processed from current block
+
+        uint64_t m_newLines = 0; /// bit set for every '\n' in block
+        uint64_t m_delimiters = 0; /// bit set for every ' ', '\t', '\r', '\n', '#'
+        uint64_t m_comments = 0; /// bit set for every '#' in block
+    };
+}
+
+#endif /* LineScanner_h */
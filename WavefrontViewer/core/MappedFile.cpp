@@ -0,0 +1,66 @@
+//
+//  MappedFile.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include "MappedFile.h"
+
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace WavefrontFileReader
+{
+    MappedFile::MappedFile(const std::string& filePath)
+    {
+        int fd = ::open(filePath.c_str(), O_RDONLY);
+
+        if( fd < 0 )
+        {
+            throw std::runtime_error("Could not open file");
+        }
+
+        struct stat info;
+        if( (fstat(fd, &info) != 0) || !S_ISREG(info.st_mode) )
+        {
+            ::close(fd);
+            throw std::runtime_error("Could not open file");
+        }
+
+        m_size = size_t(info.st_size);
+
+        if( m_size > 0 )
+        {
+            void* ptr = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if( ptr == MAP_FAILED )
+            {
+                ::close(fd);
+                throw std::runtime_error("Could not map file");
+            }
+
+            // the file is parsed front to back
+            madvise(ptr, m_size, MADV_SEQUENTIAL);
+
+            m_data = static_cast<const char*>(ptr);
+        }
+
+        // the mapping stays valid after the descriptor is closed
+        ::close(fd);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if( m_data != nullptr )
+        {
+            munmap(const_cast<char*>(m_data), m_size);
+            m_data = nullptr;
+        }
+    }
+}
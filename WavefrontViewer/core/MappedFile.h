@@ -0,0 +1,48 @@
+//
+//  MappedFile.h
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#ifndef MappedFile_h
+#define MappedFile_h
+
+#include <string>
+#include <cstddef>
+
+namespace WavefrontFileReader
+{
+    /**
+     * Read only memory mapping of a file. The content is available as long
+     * as the object is alive.
+     */
+    class MappedFile
+    {
+    public:
+        /**
+         * Map the specified file in memory
+         * @param filePath - full path to the file
+         * @throw std::runtime_error if the file could not be opened or mapped
+         */
+        explicit MappedFile(const std::string& filePath);
+
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator= (const MappedFile&) = delete;
+
+        /// First byte of the file. nullptr if the file is empty
+        const char* data() const { return m_data; }
+
+        /// File size in bytes
+        size_t size() const { return m_size; }
+
+    private:
+        const char* m_data = nullptr; /// mapped file content
+        size_t m_size = 0; /// size of the mapped region
+    };
+}
+
+#endif /* MappedFile_h */
@@ -0,0 +1,737 @@
+//
+//  MeshOptimizer.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include "MeshOptimizer.h"
+#include "VertexPacking.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace WavefrontFileReader
+{
+    namespace
+    {
+        /// Size of the LRU cache used to score the vertices
+        const int kCacheSize = 32;
+
+        const size_t kNoTriangle = size_t(-1);
+
+        /**
+         * Forsyth vertex score: vertices in cache are preferred, the most
+         * recent ones more, and vertices with few triangles left get a boost
+         * so they are finished and don't need to be loaded again later
+         *
+         * @param cachePosition - position in cache or -1 when not in cache
+         * @param liveTriangles - number of triangles not emitted yet
+         */
+        float vertexScore(int cachePosition, uint32_t liveTriangles)
+        {
+            if( liveTriangles == 0 )
+            {
+                return -1.0f;
+            }
+
+            float score = 0.0f;
+            if( cachePosition >= 0 )
+            {
+                if( cachePosition < 3 )
+                {
+                    // used by the last triangle, the score doesn't depend on
+                    // the order the triangle vertices were added
+                    score = 0.75f;
+                }
+                else
+                {
+                    const float scale = 1.0f / (kCacheSize - 3);
+                    score = std::pow(1.0f - (cachePosition - 3) * scale, 1.5f);
+                }
+            }
+
+            return score + 2.0f / std::sqrt(float(liveTriangles));
+        }
+
+        /// Indices of command, without the base vertex
+        std::vector<uint32_t> commandIndices(const VertexBuffer& buffer, const Command& command)
+        {
+            std::vector<uint32_t> indices(command.count);
+            for( uint32_t i = 0; i < command.count; ++i )
+            {
+                indices[i] = buffer.index(command.index + i);
+            }
+            return indices;
+        }
+
+        /// Commands of the buffer followed by the commands of every level of detail
+        std::vector<Command> allCommands(const VertexBuffer& buffer)
+        {
+            std::vector<Command> commands(buffer.commands);
+            for( const auto& lod : buffer.lods )
+            {
+                commands.insert(commands.end(), lod.commands.begin(), lod.commands.end());
+            }
+            return commands;
+        }
+
+        /// Replace the indices of command
+        void setCommandIndices(VertexBuffer& buffer, const Command& command,
+                               const std::vector<uint32_t>& indices)
+        {
+            for( uint32_t i = 0; i < command.count; ++i )
+            {
+                if( buffer.indexSize == 2 )
+                {
+                    buffer.ibo16[command.index + i] = uint16_t(indices[i]);
+                }
+                else
+                {
+                    buffer.ibo[command.index + i] = indices[i];
+                }
+            }
+        }
+
+        /**
+         * Renumber the vertices used by indices from 0, in order of first use
+         * @param indices - indices that are renumbered
+         * @param vertices - receives the original number of every vertex
+         */
+        void makeLocal(std::vector<uint32_t>& indices, std::vector<uint32_t>& vertices)
+        {
+            // indices are sorted to find the vertices, without a table as large
+            // as the whole vertex buffer
+            std::vector<uint32_t> sorted(indices);
+            std::sort(sorted.begin(), sorted.end());
+            sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+            for( auto& index : indices )
+            {
+                index = uint32_t(std::lower_bound(sorted.begin(), sorted.end(), index) -
+                                 sorted.begin());
+            }
+            vertices.swap(sorted);
+        }
+
+        /**
+         * Forsyth optimization of a triangle list
+         * @param indices - triangles using vertices 0..verticesCount-1
+         * @param verticesCount - number of vertices
+         * @return Triangles in the new order
+         */
+        std::vector<uint32_t> forsyth(const std::vector<uint32_t>& indices, size_t verticesCount)
+        {
+            const size_t trianglesCount = indices.size() / 3;
+
+            // triangles of every vertex. The first liveTriangles[v] entries of
+            // a vertex are the triangles that were not emitted yet
+            std::vector<uint32_t> liveTriangles(verticesCount, 0);
+            for( size_t i = 0; i < trianglesCount * 3; ++i )
+            {
+                ++liveTriangles[indices[i]];
+            }
+
+            std::vector<uint32_t> offsets(verticesCount + 1, 0);
+            for( size_t v = 0; v < verticesCount; ++v )
+            {
+                offsets[v + 1] = offsets[v] + liveTriangles[v];
+            }
+
+            std::vector<uint32_t> adjacency(trianglesCount * 3);
+            {
+                std::vector<uint32_t> filled(offsets.begin(), offsets.end() - 1);
+                for( size_t i = 0; i < trianglesCount * 3; ++i )
+                {
+                    adjacency[filled[indices[i]]++] = uint32_t(i / 3);
+                }
+            }
+
+            std::vector<int> cachePosition(verticesCount, -1);
+            std::vector<float> vertexScores(verticesCount);
+            for( size_t v = 0; v < verticesCount; ++v )
+            {
+                vertexScores[v] = vertexScore(-1, liveTriangles[v]);
+            }
+
+            std::vector<float> triangleScores(trianglesCount);
+            std::vector<bool> emitted(trianglesCount, false);
+            size_t best = kNoTriangle;
+            float bestScore = -1.0f;
+            for( size_t t = 0; t < trianglesCount; ++t )
+            {
+                triangleScores[t] = vertexScores[indices[3 * t]] +
+                                    vertexScores[indices[3 * t + 1]] +
+                                    vertexScores[indices[3 * t + 2]];
+                if( triangleScores[t] > bestScore )
+                {
+                    bestScore = triangleScores[t];
+                    best = t;
+                }
+            }
+
+            std::vector<uint32_t> result;
+            result.reserve(trianglesCount * 3);
+
+            std::vector<uint32_t> cache, newCache;
+            cache.reserve(kCacheSize + 3);
+            newCache.reserve(kCacheSize + 3);
+
+            size_t nextUnemitted = 0;
+
+            while( result.size() < trianglesCount * 3 )
+            {
+                if( best == kNoTriangle )
+                {
+                    // no triangle uses a cached vertex, continue with the
+                    // first triangle that wasn't emitted
+                    while( emitted[nextUnemitted] )
+                    {
+                        ++nextUnemitted;
+                    }
+                    best = nextUnemitted;
+                }
+
+                const uint32_t* triangle = &indices[3 * best];
+                emitted[best] = true;
+                result.insert(result.end(), triangle, triangle + 3);
+
+                // remove the triangle from the live triangles of its vertices
+                for( int i = 0; i < 3; ++i )
+                {
+                    const uint32_t v = triangle[i];
+                    uint32_t* first = &adjacency[offsets[v]];
+                    uint32_t* last = first + liveTriangles[v];
+                    std::iter_swap(std::find(first, last, uint32_t(best)), last - 1);
+                    --liveTriangles[v];
+                }
+
+                // the triangle vertices move in front of the cache
+                newCache.assign(triangle, triangle + 3);
+                for( const auto v : cache )
+                {
+                    if( (v != triangle[0]) && (v != triangle[1]) && (v != triangle[2]) )
+                    {
+                        newCache.push_back(v);
+                    }
+                }
+
+                for( size_t i = 0; i < newCache.size(); ++i )
+                {
+                    const uint32_t v = newCache[i];
+                    cachePosition[v] = (i < size_t(kCacheSize)) ? int(i) : -1;
+                    vertexScores[v] = vertexScore(cachePosition[v], liveTriangles[v]);
+                }
+
+                // only triangles of the changed vertices have new scores
+                best = kNoTriangle;
+                bestScore = -1.0f;
+                for( const auto v : newCache )
+                {
+                    for( uint32_t i = 0; i < liveTriangles[v]; ++i )
+                    {
+                        const uint32_t t = adjacency[offsets[v] + i];
+                        triangleScores[t] = vertexScores[indices[3 * t]] +
+                                            vertexScores[indices[3 * t + 1]] +
+                                            vertexScores[indices[3 * t + 2]];
+                        if( triangleScores[t] > bestScore )
+                        {
+                            bestScore = triangleScores[t];
+                            best = t;
+                        }
+                    }
+                }
+
+                newCache.resize(std::min(newCache.size(), size_t(kCacheSize)));
+                cache.swap(newCache);
+            }
+
+            return result;
+        }
+
+        /**
+         * Depth buffer rasterizer that counts the fragments passing the
+         * depth test
+         */
+        class OverdrawRasterizer
+        {
+        public:
+            explicit OverdrawRasterizer(unsigned resolution)
+            : m_resolution(int(resolution)),
+              m_depth(size_t(resolution) * resolution, std::numeric_limits<float>::max())
+            {}
+
+            /// Triangle with x and y in pixels and z the depth, smaller is closer
+            void draw(const fvec3& a, const fvec3& b, const fvec3& c)
+            {
+                const float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+                if( area == 0.0f )
+                {
+                    return;
+                }
+
+                // both windings are drawn, there is no back face culling
+                const float sign = (area > 0.0f) ? 1.0f : -1.0f;
+                const float inverseArea = 1.0f / std::fabs(area);
+
+                const int minX = std::max(0, int(std::floor(std::min(a.x, std::min(b.x, c.x)))));
+                const int maxX = std::min(m_resolution - 1,
+                                          int(std::ceil(std::max(a.x, std::max(b.x, c.x)))));
+                const int minY = std::max(0, int(std::floor(std::min(a.y, std::min(b.y, c.y)))));
+                const int maxY = std::min(m_resolution - 1,
+                                          int(std::ceil(std::max(a.y, std::max(b.y, c.y)))));
+
+                for( int y = minY; y <= maxY; ++y )
+                {
+                    for( int x = minX; x <= maxX; ++x )
+                    {
+                        const float px = x + 0.5f, py = y + 0.5f;
+                        const float wa = sign * ((c.x - b.x) * (py - b.y) - (c.y - b.y) * (px - b.x));
+                        const float wb = sign * ((a.x - c.x) * (py - c.y) - (a.y - c.y) * (px - c.x));
+                        const float wc = sign * ((b.x - a.x) * (py - a.y) - (b.y - a.y) * (px - a.x));
+                        if( (wa < 0.0f) || (wb < 0.0f) || (wc < 0.0f) )
+                        {
+                            continue;
+                        }
+
+                        const float depth = (wa * a.z + wb * b.z + wc * c.z) * inverseArea;
+                        float& stored = m_depth[size_t(y) * m_resolution + x];
+                        if( depth < stored )
+                        {
+                            m_covered += (stored == std::numeric_limits<float>::max());
+                            stored = depth;
+                            ++m_shaded;
+                        }
+                    }
+                }
+            }
+
+            size_t covered() const { return m_covered; }
+            size_t shaded() const { return m_shaded; }
+
+        private:
+            int m_resolution; /// width and height in pixels
+            std::vector<float> m_depth; /// depth buffer
+            size_t m_covered = 0; /// pixels drawn at least once
+            size_t m_shaded = 0; /// fragments that passed the depth test
+        };
+
+        /// Consecutive triangles that are moved together
+        struct Cluster
+        {
+            uint32_t first = 0; /// first triangle
+            uint32_t count = 0; /// number of triangles
+            float sortKey = 0.0f; /// clusters with larger keys are drawn first
+        };
+
+        /**
+         * Split the triangles in clusters. A cluster ends before a triangle
+         * with all the vertices missing from cache, or when the cluster cache
+         * efficiency is close enough to the efficiency of all the triangles
+         */
+        std::vector<Cluster> makeClusters(const std::vector<uint32_t>& indices, float threshold)
+        {
+            const unsigned kCacheSize = 16;
+            const uint32_t trianglesCount = uint32_t(indices.size() / 3);
+
+            // misses of every triangle with a cache that is never reset
+            std::vector<uint32_t> cache(kCacheSize, uint32_t(-1));
+            size_t next = 0, transforms = 0;
+            auto lookup = [&cache, &next](uint32_t vertex) -> unsigned {
+                if( std::find(cache.begin(), cache.end(), vertex) != cache.end() )
+                {
+                    return 0;
+                }
+                cache[next] = vertex;
+                next = (next + 1) % cache.size();
+                return 1;
+            };
+
+            for( const auto index : indices )
+            {
+                transforms += lookup(index);
+            }
+            const float acmr = float(transforms) / trianglesCount;
+
+            std::vector<Cluster> clusters;
+            Cluster cluster;
+            size_t clusterTransforms = 0;
+
+            std::fill(cache.begin(), cache.end(), uint32_t(-1));
+            next = 0;
+
+            for( uint32_t t = 0; t < trianglesCount; ++t )
+            {
+                const unsigned misses = lookup(indices[3 * t]) + lookup(indices[3 * t + 1]) +
+                                        lookup(indices[3 * t + 2]);
+
+                if( (cluster.count > 0) && (misses == 3) )
+                {
+                    clusters.push_back(cluster);
+                    cluster.first = t;
+                    cluster.count = 0;
+                    clusterTransforms = 0;
+                }
+
+                ++cluster.count;
+                clusterTransforms += misses;
+
+                if( float(clusterTransforms) / cluster.count <= threshold * acmr )
+                {
+                    // the next cluster starts with an empty cache
+                    clusters.push_back(cluster);
+                    cluster.first = t + 1;
+                    cluster.count = 0;
+                    clusterTransforms = 0;
+                    std::fill(cache.begin(), cache.end(), uint32_t(-1));
+                }
+            }
+
+            if( cluster.count > 0 )
+            {
+                clusters.push_back(cluster);
+            }
+            return clusters;
+        }
+    }
+
+    VertexCacheStatistics analyzeVertexCache(const VertexBuffer& buffer, unsigned cacheSize)
+    {
+        VertexCacheStatistics statistics;
+
+        std::vector<uint32_t> usedVertices;
+        std::vector<uint32_t> cache;
+
+        for( const auto& command : buffer.commands )
+        {
+            if( command.type != Command::Triangles )
+            {
+                continue;
+            }
+
+            // FIFO cache, vertices hit in cache don't move
+            cache.assign(cacheSize, uint32_t(-1));
+            size_t next = 0;
+
+            const uint32_t end = command.index + command.count - command.count % 3;
+            for( uint32_t i = command.index; i < end; ++i )
+            {
+                const uint32_t vertex = buffer.index(i) + command.baseVertex;
+                usedVertices.push_back(vertex);
+
+                if( std::find(cache.begin(), cache.end(), vertex) == cache.end() )
+                {
+                    cache[next] = vertex;
+                    next = (next + 1) % cacheSize;
+                    ++statistics.transforms;
+                }
+            }
+
+            statistics.triangles += command.count / 3;
+        }
+
+        std::sort(usedVertices.begin(), usedVertices.end());
+        statistics.vertices = size_t(std::unique(usedVertices.begin(), usedVertices.end()) -
+                                     usedVertices.begin());
+
+        if( statistics.triangles > 0 )
+        {
+            statistics.acmr = float(statistics.transforms) / statistics.triangles;
+            statistics.atvr = float(statistics.transforms) / statistics.vertices;
+        }
+
+        return statistics;
+    }
+
+    void optimizeVertexCache(VertexBuffer& buffer)
+    {
+        // the triangles move between meshlets
+        buffer.meshlets.clear();
+
+        std::vector<uint32_t> vertices;
+
+        for( const auto& command : allCommands(buffer) )
+        {
+            if( (command.type != Command::Triangles) || (command.count < 6) )
+            {
+                continue;
+            }
+
+            auto indices = commandIndices(buffer, command);
+
+            // an incomplete last triangle stays at the end
+            const size_t trianglesEnd = indices.size() - indices.size() % 3;
+            std::vector<uint32_t> triangles(indices.begin(), indices.begin() + trianglesEnd);
+
+            makeLocal(triangles, vertices);
+            triangles = forsyth(triangles, vertices.size());
+
+            for( size_t i = 0; i < trianglesEnd; ++i )
+            {
+                indices[i] = vertices[triangles[i]];
+            }
+
+            setCommandIndices(buffer, command, indices);
+        }
+    }
+
+    void optimizeVertexFetch(VertexBuffer& buffer)
+    {
+        assert( buffer.indexSize == 4 );
+        if( buffer.indexSize != 4 )
+        {
+            return;
+        }
+
+        const uint32_t kUnused = uint32_t(-1);
+        const size_t verticesCount = buffer.verticesCount();
+
+        // new number of every vertex, in order of first use
+        std::vector<uint32_t> remap(verticesCount, kUnused);
+        uint32_t usedCount = 0;
+
+        auto renumber = [&](Command& command) {
+            for( uint32_t i = command.index; i < command.index + command.count; ++i )
+            {
+                const uint32_t vertex = buffer.ibo[i] + command.baseVertex;
+                if( remap[vertex] == kUnused )
+                {
+                    remap[vertex] = usedCount++;
+                }
+                buffer.ibo[i] = remap[vertex];
+            }
+
+            command.baseVertex = 0;
+        };
+
+        for( auto& command : buffer.commands )
+        {
+            renumber(command);
+        }
+
+        // the levels of detail share the ranges of the commands they don't change
+        std::vector<bool> renumbered(buffer.ibo.size(), false);
+        for( const auto& command : buffer.commands )
+        {
+            std::fill(renumbered.begin() + command.index,
+                      renumbered.begin() + command.index + command.count, true);
+        }
+        for( auto& lod : buffer.lods )
+        {
+            for( auto& command : lod.commands )
+            {
+                if( (command.count > 0) && !renumbered[command.index] )
+                {
+                    renumber(command);
+                }
+                else
+                {
+                    command.baseVertex = 0;
+                }
+            }
+        }
+
+        if( buffer.layout.format == VertexLayout::Float32 )
+        {
+            std::vector<Vertex> vbo(usedCount);
+            for( size_t v = 0; v < verticesCount; ++v )
+            {
+                if( remap[v] != kUnused )
+                {
+                    vbo[remap[v]] = buffer.vbo[v];
+                }
+            }
+            buffer.vbo.swap(vbo);
+        }
+        else
+        {
+            const size_t stride = buffer.layout.stride;
+            std::vector<uint8_t> vbo(usedCount * stride);
+            for( size_t v = 0; v < verticesCount; ++v )
+            {
+                if( remap[v] != kUnused )
+                {
+                    memcpy(&vbo[remap[v] * stride], &buffer.packedVbo[v * stride], stride);
+                }
+            }
+            buffer.packedVbo.swap(vbo);
+        }
+    }
+
+    OverdrawStatistics analyzeOverdraw(const VertexBuffer& buffer, unsigned resolution)
+    {
+        OverdrawStatistics statistics;
+
+        const auto positions = vertexPositions(buffer);
+        if( positions.empty() )
+        {
+            return statistics;
+        }
+
+        // bounding sphere, every view fits it in the viewport
+        fvec3 low = positions.front(), high = positions.front();
+        for( const auto& position : positions )
+        {
+            low = fvec3(std::min(low.x, position.x), std::min(low.y, position.y),
+                        std::min(low.z, position.z));
+            high = fvec3(std::max(high.x, position.x), std::max(high.y, position.y),
+                         std::max(high.z, position.z));
+        }
+        const fvec3 center = (low + high) * 0.5f;
+        float radius = 0.0f;
+        for( const auto& position : positions )
+        {
+            radius = std::max(radius, dot(position - center, position - center));
+        }
+        radius = std::sqrt(radius);
+        if( radius == 0.0f )
+        {
+            return statistics;
+        }
+
+        const float scale = 0.5f * resolution / radius;
+        std::vector<fvec3> projected(positions.size());
+
+        // directions to the corners, edges and faces of a cube
+        for( int i = 0; i < 27; ++i )
+        {
+            const int dx = i % 3 - 1, dy = (i / 3) % 3 - 1, dz = i / 9 - 1;
+            if( (dx == 0) && (dy == 0) && (dz == 0) )
+            {
+                continue;
+            }
+
+            const fvec3 direction = normalize(fvec3(float(dx), float(dy), float(dz)));
+            const fvec3 up = (std::fabs(direction.x) < 0.9f) ? fvec3(1.0f, 0.0f, 0.0f)
+                                                             : fvec3(0.0f, 1.0f, 0.0f);
+            const fvec3 u = normalize(cross(up, direction));
+            const fvec3 v = cross(direction, u);
+
+            for( size_t i = 0; i < positions.size(); ++i )
+            {
+                const fvec3 p = positions[i] - center;
+                projected[i] = fvec3(dot(p, u) * scale + 0.5f * resolution,
+                                     dot(p, v) * scale + 0.5f * resolution,
+                                     dot(p, direction));
+            }
+
+            OverdrawRasterizer rasterizer(resolution);
+            for( const auto& command : buffer.commands )
+            {
+                if( command.type != Command::Triangles )
+                {
+                    continue;
+                }
+
+                for( uint32_t i = command.index; i + 2 < command.index + command.count; i += 3 )
+                {
+                    rasterizer.draw(projected[buffer.index(i) + command.baseVertex],
+                                    projected[buffer.index(i + 1) + command.baseVertex],
+                                    projected[buffer.index(i + 2) + command.baseVertex]);
+                }
+            }
+
+            statistics.covered += rasterizer.covered();
+            statistics.shaded += rasterizer.shaded();
+        }
+
+        if( statistics.covered > 0 )
+        {
+            statistics.overdraw = float(statistics.shaded) / statistics.covered;
+        }
+        return statistics;
+    }
+
+    void optimizeOverdraw(VertexBuffer& buffer, float threshold)
+    {
+        // the triangles move between meshlets
+        buffer.meshlets.clear();
+
+        const auto positions = vertexPositions(buffer);
+
+        for( const auto& command : allCommands(buffer) )
+        {
+            if( (command.type != Command::Triangles) || (command.count < 6) )
+            {
+                continue;
+            }
+
+            auto indices = commandIndices(buffer, command);
+            const size_t trianglesEnd = indices.size() - indices.size() % 3;
+            const std::vector<uint32_t> triangles(indices.begin(),
+                                                  indices.begin() + trianglesEnd);
+
+            auto clusters = makeClusters(triangles, threshold);
+            if( clusters.size() <= 1 )
+            {
+                continue;
+            }
+
+            auto position = [&](uint32_t t, int corner) -> const fvec3& {
+                return positions[triangles[3 * t + corner] + command.baseVertex];
+            };
+
+            // area weighted centroids and normals
+            std::vector<fvec3> centroids(clusters.size()), normals(clusters.size());
+            fvec3 meshCentroid;
+            float meshArea = 0.0f;
+
+            for( size_t c = 0; c < clusters.size(); ++c )
+            {
+                fvec3 centroid, normal;
+                float area = 0.0f;
+                for( uint32_t t = clusters[c].first; t < clusters[c].first + clusters[c].count; ++t )
+                {
+                    const fvec3 crossProduct = cross(position(t, 1) - position(t, 0),
+                                                     position(t, 2) - position(t, 0));
+                    const float triangleArea = std::sqrt(dot(crossProduct, crossProduct));
+                    const fvec3 triangleCentroid = (position(t, 0) + position(t, 1) +
+                                                    position(t, 2)) * (1.0f / 3.0f);
+
+                    centroid = centroid + triangleCentroid * triangleArea;
+                    normal = normal + crossProduct;
+                    area += triangleArea;
+                }
+
+                meshCentroid = meshCentroid + centroid;
+                meshArea += area;
+
+                centroids[c] = (area > 0.0f) ? centroid * (1.0f / area) : position(clusters[c].first, 0);
+                normals[c] = normalize(normal);
+            }
+
+            if( meshArea > 0.0f )
+            {
+                meshCentroid = meshCentroid * (1.0f / meshArea);
+            }
+
+            for( size_t c = 0; c < clusters.size(); ++c )
+            {
+                clusters[c].sortKey = dot(centroids[c] - meshCentroid, normals[c]);
+            }
+
+            std::stable_sort(clusters.begin(), clusters.end(),
+                             [](const Cluster& a, const Cluster& b) {
+                                 return a.sortKey > b.sortKey;
+                             });
+
+            size_t output = 0;
+            for( const auto& cluster : clusters )
+            {
+                for( uint32_t t = cluster.first; t < cluster.first + cluster.count; ++t )
+                {
+                    indices[output++] = triangles[3 * t];
+                    indices[output++] = triangles[3 * t + 1];
+                    indices[output++] = triangles[3 * t + 2];
+                }
+            }
+
+            setCommandIndices(buffer, command, indices);
+        }
+    }
+}
@@ -0,0 +1,112 @@
+//
+//  MeshOptimizer.h
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#ifndef MeshOptimizer_h
+#define MeshOptimizer_h
+
+#include <cstddef>
+
+#include "IObject.h"
+
+/**
+ * Passes that reorder the indices of a @see VertexBuffer for faster drawing.
+ * Only the Triangles commands are changed, the drawn triangles stay the same.
+ * The commands of the levels of detail are optimized too, the analysis only
+ * looks at the full detail. Passes that move triangles remove the meshlets
+ * of the buffer.
+ */
+namespace WavefrontFileReader
+{
+    /**
+     * Post transform vertex cache statistics of a buffer
+     */
+    struct VertexCacheStatistics
+    {
+        size_t triangles = 0; /// number of triangles drawn
+        size_t vertices = 0; /// number of different vertices used by the triangles
+        size_t transforms = 0; /// number of vertex shader runs, the cache misses
+
+        /// Average cache miss ratio, transformed vertices per triangle. Between
+        /// 0.5 and 3, lower is better
+        float acmr = 0.0f;
+
+        /// Average transform to vertex ratio, transforms for every vertex.
+        /// 1 is the best possible value
+        float atvr = 0.0f;
+    };
+
+    /**
+     * Overdraw statistics of a buffer rendered with depth test and without
+     * back face culling, averaged over several view directions
+     */
+    struct OverdrawStatistics
+    {
+        size_t covered = 0; /// pixels covered by the mesh, from all directions
+        size_t shaded = 0; /// fragments that passed the depth test
+
+        /// Fragments shaded for every covered pixel. 1 is the best possible value
+        float overdraw = 0.0f;
+    };
+
+    /**
+     * Simulate the post transform vertex cache while the Triangles commands
+     * are drawn. The cache is reset between commands.
+     *
+     * @param buffer - buffer to analyze
+     * @param cacheSize - number of vertices in the simulated FIFO cache
+     */
+    VertexCacheStatistics analyzeVertexCache(const VertexBuffer& buffer,
+                                             unsigned cacheSize = 16);
+
+    /**
+     * Reorder the triangles of every Triangles command so that consecutive
+     * triangles share vertices, using Tom Forsyth's linear speed vertex
+     * cache optimization. The vertices of a triangle keep their order, so
+     * the winding doesn't change.
+     *
+     * @param buffer - buffer to optimize
+     */
+    void optimizeVertexCache(VertexBuffer& buffer);
+
+    /**
+     * Estimate the overdraw by rasterizing the Triangles commands, in draw
+     * order, with orthographic projections from 26 directions around the mesh
+     *
+     * @param buffer - buffer to analyze
+     * @param resolution - width and height of the simulated viewport
+     */
+    OverdrawStatistics analyzeOverdraw(const VertexBuffer& buffer,
+                                       unsigned resolution = 256);
+
+    /**
+     * Split every Triangles command in clusters and draw first the clusters
+     * most likely to hide the others, the ones far from the mesh center that
+     * face outwards. This doesn't depend on the view direction.
+     *
+     * Clusters start where the vertex cache would be reloaded anyway, and
+     * wherever the cache efficiency is still good enough. Run it after
+     * @see optimizeVertexCache.
+     *
+     * @param buffer - buffer to optimize
+     * @param threshold - accepted vertex cache degradation, 1.05 allows the
+     *              ACMR of the clusters to be 5% worse than the command
+     */
+    void optimizeOverdraw(VertexBuffer& buffer, float threshold = 1.05f);
+
+    /**
+     * Renumber the vertices in the order they are first used by the index
+     * buffer and move them accordingly, so the vertices of a command are
+     * close in memory and read in order. Vertices not used by any command
+     * are removed. Run it after @see optimizeVertexCache.
+     *
+     * @param buffer - buffer with 32 bits indices, in any vertex format
+     */
+    void optimizeVertexFetch(VertexBuffer& buffer);
+}
+
+#endif /* MeshOptimizer_h */
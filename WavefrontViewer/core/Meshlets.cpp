@@ -0,0 +1,169 @@
+//
+//  Meshlets.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include "Meshlets.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "VertexPacking.h"
+
+namespace WavefrontFileReader
+{
+    namespace
+    {
+        /**
+         * Compute the bounding sphere and the normal cone of a meshlet
+         * @param buffer - buffer that contains the meshlet
+         * @param positions - positions of all the vertices of the buffer
+         * @param meshlet - meshlet with the index range set
+         */
+        void computeBounds(const VertexBuffer& buffer, const std::vector<fvec3>& positions,
+                           Meshlet& meshlet)
+        {
+            const uint32_t baseVertex = buffer.commands[meshlet.command].baseVertex;
+            auto position = [&](uint32_t i) -> const fvec3& {
+                return positions[buffer.index(i) + baseVertex];
+            };
+
+            // sphere around the center of the bounding box
+            fvec3 low = position(meshlet.index), high = low;
+            for( uint32_t i = meshlet.index; i < meshlet.index + meshlet.count; ++i )
+            {
+                const fvec3& p = position(i);
+                low = fvec3(std::min(low.x, p.x), std::min(low.y, p.y), std::min(low.z, p.z));
+                high = fvec3(std::max(high.x, p.x), std::max(high.y, p.y), std::max(high.z, p.z));
+            }
+
+            meshlet.center = (low + high) * 0.5f;
+            meshlet.radius = 0.0f;
+            for( uint32_t i = meshlet.index; i < meshlet.index + meshlet.count; ++i )
+            {
+                meshlet.radius = std::max(meshlet.radius, length(position(i) - meshlet.center));
+            }
+
+            // cone around the average of the triangle normals
+            std::vector<fvec3> normals;
+            normals.reserve(meshlet.count / 3);
+            fvec3 axis;
+            for( uint32_t i = meshlet.index; i + 2 < meshlet.index + meshlet.count; i += 3 )
+            {
+                const fvec3 normal = normalize(cross(position(i + 1) - position(i),
+                                                     position(i + 2) - position(i)));
+                if( dot(normal, normal) > 0.0f )
+                {
+                    normals.push_back(normal);
+                    axis = axis + normal;
+                }
+            }
+
+            meshlet.coneAxis = normalize(axis);
+            meshlet.coneCutoff = 1.0f;
+
+            if( normals.empty() || (dot(meshlet.coneAxis, meshlet.coneAxis) == 0.0f) )
+            {
+                return;
+            }
+
+            float minimumDot = 1.0f;
+            for( const auto& normal : normals )
+            {
+                minimumDot = std::min(minimumDot, dot(normal, meshlet.coneAxis));
+            }
+
+            // normals spread over more than a hemisphere are never culled
+            if( minimumDot > 0.0f )
+            {
+                meshlet.coneCutoff = std::sqrt(1.0f - minimumDot * minimumDot);
+            }
+        }
+    }
+
+    void buildMeshlets(VertexBuffer& buffer, unsigned maxVertices, unsigned maxTriangles)
+    {
+        buffer.meshlets.clear();
+
+        const auto positions = vertexPositions(buffer);
+
+        // meshlet that last used every vertex
+        std::vector<uint32_t> owner(positions.size(), uint32_t(-1));
+
+        for( uint32_t c = 0; c < buffer.commands.size(); ++c )
+        {
+            const Command& command = buffer.commands[c];
+            if( command.type != Command::Triangles )
+            {
+                continue;
+            }
+
+            Meshlet meshlet;
+            meshlet.command = c;
+            meshlet.index = command.index;
+
+            auto finish = [&]() {
+                if( meshlet.count > 0 )
+                {
+                    computeBounds(buffer, positions, meshlet);
+                    buffer.meshlets.push_back(meshlet);
+                }
+            };
+
+            // vertices of triangle i that are not in meshlet id yet
+            auto newVertices = [&](uint32_t i, uint32_t id) -> unsigned {
+                const uint32_t first = buffer.index(i) + command.baseVertex;
+                const uint32_t second = buffer.index(i + 1) + command.baseVertex;
+                const uint32_t third = buffer.index(i + 2) + command.baseVertex;
+                return (owner[first] != id) +
+                       ((owner[second] != id) && (second != first)) +
+                       ((owner[third] != id) && (third != first) && (third != second));
+            };
+
+            const uint32_t end = command.index + command.count - command.count % 3;
+            for( uint32_t i = command.index; i < end; i += 3 )
+            {
+                uint32_t id = uint32_t(buffer.meshlets.size());
+                unsigned added = newVertices(i, id);
+
+                if( (meshlet.count / 3 + 1 > maxTriangles) ||
+                    (meshlet.verticesCount + added > maxVertices) )
+                {
+                    finish();
+
+                    meshlet = Meshlet();
+                    meshlet.command = c;
+                    meshlet.index = i;
+
+                    id = uint32_t(buffer.meshlets.size());
+                    added = newVertices(i, id);
+                }
+
+                for( uint32_t k = i; k < i + 3; ++k )
+                {
+                    owner[buffer.index(k) + command.baseVertex] = id;
+                }
+                meshlet.verticesCount += added;
+                meshlet.count += 3;
+            }
+
+            finish();
+        }
+    }
+
+    bool isBackFacing(const Meshlet& meshlet, const fvec3& cameraPosition)
+    {
+        if( meshlet.coneCutoff >= 1.0f )
+        {
+            return false;
+        }
+
+        const fvec3 direction = meshlet.center - cameraPosition;
+        return dot(direction, meshlet.coneAxis) >=
+               meshlet.coneCutoff * length(direction) + meshlet.radius;
+    }
+}
@@ -0,0 +1,47 @@
+//
+//  Meshlets.h
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#ifndef Meshlets_h
+#define Meshlets_h
+
+#include "IObject.h"
+
+namespace WavefrontFileReader
+{
+    /// Default maximum number of vertices in a meshlet
+    const unsigned kMeshletMaxVertices = 64;
+
+    /// Default maximum number of triangles in a meshlet
+    const unsigned kMeshletMaxTriangles = 124;
+
+    /**
+     * Split the Triangles commands of the buffer in meshlets, stored in
+     * @see VertexBuffer::meshlets. Meshlets are consecutive ranges of the
+     * index buffer, so the indices are not changed and every meshlet can be
+     * drawn with a single glDrawElements. Run it after the passes that
+     * reorder the triangles, @see optimizeVertexCache, since it keeps
+     * neighbour triangles in the same meshlet.
+     *
+     * @param buffer - buffer to split
+     * @param maxVertices - maximum number of different vertices in a meshlet
+     * @param maxTriangles - maximum number of triangles in a meshlet
+     */
+    void buildMeshlets(VertexBuffer& buffer, unsigned maxVertices = kMeshletMaxVertices,
+                       unsigned maxTriangles = kMeshletMaxTriangles);
+
+    /**
+     * Check if all the triangles of a meshlet face away from the camera.
+     * The test is conservative, it may return false for back facing meshlets.
+     *
+     * @param meshlet - meshlet to test
+     * @param cameraPosition - camera position in model coordinates
+     */
+    bool isBackFacing(const Meshlet& meshlet, const fvec3& cameraPosition);
+}
+
+#endif /* Meshlets_h */
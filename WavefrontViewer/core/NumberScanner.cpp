@@ -0,0 +1,40 @@
+//
+//  NumberScanner.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include "NumberScanner.h"
+
+#include <cstdlib>
+#include <string>
+
+namespace WavefrontFileReader
+{
+    const char* scanFloatFallback(const char* first, const char* last, float& value)
+    {
+        // strtof needs a null terminated string
+        char buffer[128];
+        std::string longBuffer;
+
+        const size_t length = size_t(last - first);
+        const char* str = buffer;
+        if( length < sizeof(buffer) )
+        {
+            memcpy(buffer, first, length);
+            buffer[length] = '\0';
+        }
+        else
+        {
+            longBuffer.assign(first, last);
+            str = longBuffer.c_str();
+        }
+
+        char* end = nullptr;
+        value = std::strtof(str, &end);
+
+        return first + (end - str);
+    }
+}
@@ -0,0 +1,217 @@
+//
+//  NumberScanner.h
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#ifndef NumberScanner_h
+#define NumberScanner_h
+
+#include <cinttypes>
+#include <cstring>
+
+#include "types.h"
+
+/**
+ * Locale independent number parsing that works directly on character ranges.
+ * The ranges don't need to be null terminated and nothing is allocated.
+ */
+namespace WavefrontFileReader
+{
+    /**
+     * Slow path of @see scanFloat. Used for the few values that can't be
+     * converted exactly by the fast path (too many digits, subnormals, nan...)
+     */
+    const char* scanFloatFallback(const char* first, const char* last, float& value);
+
+    /**
+     * Parse a decimal floating point number. The result is correctly rounded.
+     *
+     * @param first - first character of the number
+     * @param last - one past the last character that can be read
+     * @param value - receives the number. Set to zero if no number was found
+     *
+     * @return Pointer to the first character after the number, or first when
+     *          no number was found
+     */
+    inline const char* scanFloat(const char* first, const char* last, float& value)
+    {
+        // powers of ten that are exactly representable as double
+        static const double kPowersOfTen[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        value = 0.0f;
+
+        const char* ptr = first;
+        const bool negative = (ptr < last) && (*ptr == '-');
+        if( (ptr < last) && ((*ptr == '-') || (*ptr == '+')) )
+        {
+            ++ptr;
+        }
+
+        uint64_t mantissa = 0;
+        int exponent = 0;
+        int significantDigits = 0;
+        bool hasDigits = false;
+
+        // integer part
+        for( ; (ptr < last) && (unsigned(*ptr - '0') < 10); ++ptr )
+        {
+            mantissa = mantissa * 10 + unsigned(*ptr - '0');
+            significantDigits += (mantissa != 0);
+            hasDigits = true;
+        }
+
+        // fractional part
+        if( (ptr < last) && (*ptr == '.') )
+        {
+            ++ptr;
+            for( ; (ptr < last) && (unsigned(*ptr - '0') < 10); ++ptr )
+            {
+                mantissa = mantissa * 10 + unsigned(*ptr - '0');
+                significantDigits += (mantissa != 0);
+                --exponent;
+                hasDigits = true;
+            }
+        }
+
+        if( !hasDigits )
+        {
+            // nan, inf or not a number at all
+            const bool special = (ptr < last) &&
+                (((*ptr | 0x20) == 'n') || ((*ptr | 0x20) == 'i'));
+            return special ? scanFloatFallback(first, last, value) : first;
+        }
+
+        // exponent
+        if( (ptr < last) && ((*ptr == 'e') || (*ptr == 'E')) )
+        {
+            const char* exponentStart = ptr++;
+            const bool negativeExponent = (ptr < last) && (*ptr == '-');
+            if( (ptr < last) && ((*ptr == '-') || (*ptr == '+')) )
+            {
+                ++ptr;
+            }
+
+            if( (ptr < last) && (unsigned(*ptr - '0') < 10) )
+            {
+                int explicitExponent = 0;
+                for( ; (ptr < last) && (unsigned(*ptr - '0') < 10); ++ptr )
+                {
+                    if( explicitExponent < 100000 )
+                    {
+                        explicitExponent = explicitExponent * 10 + (*ptr - '0');
+                    }
+                }
+                exponent += negativeExponent ? -explicitExponent : explicitExponent;
+            }
+            else
+            {
+                // 'e' is not followed by a number, it is not part of the value
+                ptr = exponentStart;
+            }
+        }
+
+        // when the mantissa fits in 53 bits a single multiplication or
+        // division by an exact power of ten is correctly rounded to double
+        if( (significantDigits <= 19) && (mantissa <= (uint64_t(1) << 53)) &&
+            (exponent >= -22) && (exponent <= 22) )
+        {
+            double result = double(mantissa);
+            result = (exponent < 0) ? result / kPowersOfTen[-exponent]
+                                    : result * kPowersOfTen[exponent];
+
+            if( result == 0.0 )
+            {
+                value = negative ? -0.0f : 0.0f;
+                return ptr;
+            }
+
+            // Rounding the double to float gives the correctly rounded float
+            // unless the double lies exactly halfway between two floats. For
+            // normal floats that means the 29 bits dropped from the double
+            // mantissa are 100...0
+            uint64_t bits;
+            memcpy(&bits, &result, sizeof(bits));
+
+            const uint64_t droppedBits = bits & ((uint64_t(1) << 29) - 1);
+            if( (droppedBits != (uint64_t(1) << 28)) &&
+                (result >= 1.17549435e-38) && (result <= 3.40282346e+38) )
+            {
+                value = negative ? -float(result) : float(result);
+                return ptr;
+            }
+        }
+
+        return scanFloatFallback(first, ptr, value);
+    }
+
+    /**
+     * Parse a decimal integer with optional sign
+     *
+     * @param first - first character of the number
+     * @param last - one past the last character that can be read
+     * @param value - receives the number. Set to zero if no number was found
+     *
+     * @return Pointer to the first character after the number, or first when
+     *          no number was found
+     */
+    inline const char* scanInt(const char* first, const char* last, int& value)
+    {
+        const char* ptr = first;
+        const bool negative = (ptr < last) && (*ptr == '-');
+        ptr += negative;
+
+        const char* digits = ptr;
+        uint32_t result = 0;
+        for( ; (ptr < last) && (unsigned(*ptr - '0') < 10); ++ptr )
+        {
+            result = result * 10 + unsigned(*ptr - '0');
+        }
+
+        if( ptr == digits )
+        {
+            value = 0;
+            return first;
+        }
+
+        value = negative ? -int(result) : int(result);
+        return ptr;
+    }
+
+    /**
+     * Parse a face element in one of the forms 'v', 'v/vt', 'v//vn' or
+     * 'v/vt/vn'. Missing indices are set to zero.
+     *
+     * @param first - first character of the element
+     * @param last - one past the last character of the element
+     * @param index - receives the indices
+     *
+     * @return Pointer to the first character that was not parsed
+     */
+    inline const char* scanIndexData(const char* first, const char* last,
+                                     IndexData& index)
+    {
+        index = IndexData();
+
+        const char* ptr = scanInt(first, last, index.vertexIndex);
+
+        if( (ptr < last) && (*ptr == '/') )
+        {
+            ptr = scanInt(ptr + 1, last, index.textureIndex);
+
+            if( (ptr < last) && (*ptr == '/') )
+            {
+                ptr = scanInt(ptr + 1, last, index.normalIndex);
+            }
+        }
+
+        return ptr;
+    }
+}
+
+#endif /* NumberScanner_h */
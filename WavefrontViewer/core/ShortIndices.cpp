@@ -0,0 +1,171 @@
+//
+//  ShortIndices.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include "ShortIndices.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "Bounds.h"
+
+namespace WavefrontFileReader
+{
+    namespace
+    {
+        /// Number of indices of a primitive drawn by command
+        uint32_t primitiveSize(const Command& command)
+        {
+            return (command.type == Command::Quads) ? 4 : 3;
+        }
+
+        /**
+         * Split command in ranges of whole primitives that use less than
+         * kMaxShortIndexVertices vertices
+         */
+        void splitCommand(const std::vector<uint32_t>& ibo, const Command& command,
+                          std::vector<Command>& commands)
+        {
+            const uint32_t step = primitiveSize(command);
+            const uint32_t end = command.index + command.count;
+
+            Command batch = command;
+            batch.count = 0;
+            uint32_t low = UINT32_MAX, high = 0;
+
+            for( uint32_t first = command.index; first < end; first += step )
+            {
+                const uint32_t last = std::min(end, first + step);
+
+                uint32_t primitiveLow = UINT32_MAX, primitiveHigh = 0;
+                for( uint32_t i = first; i < last; ++i )
+                {
+                    primitiveLow = std::min(primitiveLow, ibo[i]);
+                    primitiveHigh = std::max(primitiveHigh, ibo[i]);
+                }
+
+                if( (batch.count > 0) &&
+                    (std::max(high, primitiveHigh) - std::min(low, primitiveLow) >=
+                     kMaxShortIndexVertices) )
+                {
+                    commands.push_back(batch);
+                    batch.index = first;
+                    batch.count = 0;
+                    low = UINT32_MAX;
+                    high = 0;
+                }
+
+                low = std::min(low, primitiveLow);
+                high = std::max(high, primitiveHigh);
+                batch.count += last - first;
+            }
+
+            if( batch.count > 0 )
+            {
+                commands.push_back(batch);
+            }
+        }
+    }
+
+    bool convertToShortIndices(VertexBuffer& buffer, bool splitCommands)
+    {
+        if( buffer.indexSize == 2 )
+        {
+            return true;
+        }
+
+        const auto& ibo = buffer.ibo;
+
+        // split the commands and find their base vertex
+        auto convertCommands = [&](const std::vector<Command>& source,
+                                   std::vector<Command>& commands) -> bool {
+            commands.reserve(source.size());
+            for( const auto& command : source )
+            {
+                if( splitCommands )
+                {
+                    splitCommand(ibo, command, commands);
+                }
+                else
+                {
+                    commands.push_back(command);
+                }
+            }
+
+            const bool wasSplit = (commands.size() != source.size());
+            for( auto& command : commands )
+            {
+                // split commands keep the bounds of the whole command
+                // when they can't be computed
+                if( wasSplit && (buffer.layout.format == VertexLayout::Float32) )
+                {
+                    command.bounds = commandBounds(buffer, command);
+                }
+
+                const auto first = ibo.begin() + command.index;
+                const auto range = std::minmax_element(first, first + command.count);
+
+                command.baseVertex = (command.count > 0) ? *range.first : 0;
+                if( (command.count > 0) &&
+                    (*range.second - *range.first >= kMaxShortIndexVertices) )
+                {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        std::vector<Command> commands;
+        if( !convertCommands(buffer.commands, commands) )
+        {
+            return false;
+        }
+
+        std::vector<std::vector<Command>> lodCommands(buffer.lods.size());
+        for( size_t level = 0; level < buffer.lods.size(); ++level )
+        {
+            if( !convertCommands(buffer.lods[level].commands, lodCommands[level]) )
+            {
+                return false;
+            }
+        }
+
+        // the levels of detail reuse the ranges of the commands they don't
+        // change, with the same base vertex
+        std::vector<uint16_t> ibo16(ibo.size());
+        auto convertIndices = [&](const std::vector<Command>& converted) {
+            for( const auto& command : converted )
+            {
+                for( uint32_t i = command.index; i < command.index + command.count; ++i )
+                {
+                    ibo16[i] = uint16_t(ibo[i] - command.baseVertex);
+                }
+            }
+        };
+
+        convertIndices(commands);
+        for( const auto& converted : lodCommands )
+        {
+            convertIndices(converted);
+        }
+
+        buffer.ibo16.swap(ibo16);
+        buffer.ibo = std::vector<uint32_t>();
+        buffer.indexSize = 2;
+        if( commands.size() != buffer.commands.size() )
+        {
+            // meshlets point to the commands that were split
+            buffer.meshlets.clear();
+        }
+        buffer.commands.swap(commands);
+        for( size_t level = 0; level < buffer.lods.size(); ++level )
+        {
+            buffer.lods[level].commands.swap(lodCommands[level]);
+        }
+        return true;
+    }
+}
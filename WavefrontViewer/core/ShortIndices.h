@@ -0,0 +1,35 @@
+//
+//  ShortIndices.h
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#ifndef ShortIndices_h
+#define ShortIndices_h
+
+#include "IObject.h"
+
+namespace WavefrontFileReader
+{
+    /// Maximum number of vertices that a command can use with 16 bits indices
+    const uint32_t kMaxShortIndexVertices = 65536;
+
+    /**
+     * Replace the 32 bits indices of the buffer with 16 bits indices. Every
+     * command stores the smallest vertex it uses as base vertex and its
+     * indices relative to it, so a command only needs to use less than
+     * 65536 vertices, not the whole buffer.
+     *
+     * @param buffer - buffer with 32 bits indices
+     * @param splitCommands - split the commands that use too many vertices
+     *              in several commands. Triangles and quads are never split
+     *
+     * @return Returns true when the indices were converted. The buffer is
+     *          not changed when a command uses too many vertices
+     */
+    bool convertToShortIndices(VertexBuffer& buffer, bool splitCommands);
+}
+
+#endif /* ShortIndices_h */
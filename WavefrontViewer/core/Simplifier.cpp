@@ -0,0 +1,716 @@
+//
+//  Simplifier.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include "Simplifier.h"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <cassert>
+#include <cmath>
+
+#include "Bounds.h"
+#include "VertexPacking.h"
+
+namespace WavefrontFileReader
+{
+    namespace
+    {
+        /// Weight of the planes that keep the open borders in place
+        const double kBorderWeight = 10.0;
+
+        /// Weight of the planes that keep the seams in place
+        const double kSeamWeight = 1.0;
+
+        /**
+         * Sum of the weighted squared distances to a set of planes
+         */
+        struct Quadric
+        {
+            double a00 = 0.0, a01 = 0.0, a02 = 0.0;
+            double a11 = 0.0, a12 = 0.0, a22 = 0.0;
+            double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+            double c = 0.0;
+            double weight = 0.0; /// sum of the plane weights
+
+            /// Add the plane through point with the normal of length 1
+            void addPlane(const fvec3& normal, const fvec3& point, double w)
+            {
+                const double x = normal.x, y = normal.y, z = normal.z;
+                const double d = -dot(normal, point);
+
+                a00 += w * x * x;
+                a01 += w * x * y;
+                a02 += w * x * z;
+                a11 += w * y * y;
+                a12 += w * y * z;
+                a22 += w * z * z;
+                b0 += w * x * d;
+                b1 += w * y * d;
+                b2 += w * z * d;
+                c += w * d * d;
+                weight += w;
+            }
+
+            void add(const Quadric& other)
+            {
+                a00 += other.a00;
+                a01 += other.a01;
+                a02 += other.a02;
+                a11 += other.a11;
+                a12 += other.a12;
+                a22 += other.a22;
+                b0 += other.b0;
+                b1 += other.b1;
+                b2 += other.b2;
+                c += other.c;
+                weight += other.weight;
+            }
+
+            /// Weighted mean of the squared distances between p and the planes
+            double error(const fvec3& p) const
+            {
+                if( weight <= 0.0 )
+                {
+                    return 0.0;
+                }
+
+                const double x = p.x, y = p.y, z = p.z;
+                const double e = a00 * x * x + a11 * y * y + a22 * z * z +
+                                 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+                                 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+                return std::max(e, 0.0) / weight;
+            }
+        };
+
+        /// How a point may move
+        enum PointKind
+        {
+            Manifold, /// inside the surface, moves to any neighbour
+            Border,   /// on an open border, moves along the border
+            Seam,     /// between two sets of attributes, moves along the seam
+            Locked    /// never moves
+        };
+
+        /// Key of the directed edge a -> b
+        inline uint64_t edgeKey(uint32_t a, uint32_t b)
+        {
+            return (uint64_t(a) << 32) | b;
+        }
+
+        /**
+         * Simplifies a triangle list by collapsing edges. The vertices
+         * (positions with attributes) are numbered from 0 and the vertices
+         * with the same position share a point, points are what collapses.
+         */
+        class TriangleSimplifier
+        {
+        public:
+            /**
+             * @param positions - position of every vertex
+             * @param indices - triangles, using the vertices
+             */
+            TriangleSimplifier(const std::vector<fvec3>& positions,
+                               const std::vector<uint32_t>& indices);
+
+            /// Collapse edges until at most targetCount triangles are left
+            void simplify(size_t targetCount);
+
+            /// Triangles left
+            const std::vector<uint32_t>& indices() const { return m_indices; }
+
+            /// Largest error of the collapses done so far, in model units
+            float error() const { return float(std::sqrt(m_error)); }
+
+        private:
+            /// Possible collapse of point from into point to
+            struct Collapse
+            {
+                uint32_t from = 0;
+                uint32_t to = 0;
+                double error = 0.0;
+            };
+
+            /// Find the edges, the triangles of every point and the point kinds
+            void buildTopology();
+
+            bool hasPointEdge(uint32_t a, uint32_t b) const
+            {
+                return std::binary_search(m_pointEdges.begin(), m_pointEdges.end(), edgeKey(a, b));
+            }
+
+            bool hasVertexEdge(uint32_t a, uint32_t b) const
+            {
+                return std::binary_search(m_vertexEdges.begin(), m_vertexEdges.end(), edgeKey(a, b));
+            }
+
+            /// Call visit(a, b, border, seam) for every edge a -> b of every triangle
+            void forEachEdge(const std::function<void(uint32_t, uint32_t, bool, bool)>& visit) const;
+
+            /**
+             * Check that a collapse keeps the attributes and doesn't flip
+             * triangles, and find the vertex replacing every vertex of from
+             * @param collapse - collapse to check
+             * @param remap - receives the new vertex of the vertices of from
+             * @return Returns the number of triangles removed, 0 when the
+             *          collapse is not possible
+             */
+            size_t prepareCollapse(const Collapse& collapse, std::vector<uint32_t>& remap) const;
+
+        private:
+            std::vector<fvec3> m_points; /// position of every point
+            std::vector<uint32_t> m_pointOf; /// point of every vertex
+            std::vector<uint32_t> m_indices; /// triangles, using the vertices
+            std::vector<Quadric> m_quadrics; /// quadric of every point
+            double m_error = 0.0; /// largest squared error of the collapses
+
+            std::vector<uint64_t> m_pointEdges; /// directed edges between points, sorted
+            std::vector<uint64_t> m_vertexEdges; /// directed edges between vertices, sorted
+            std::vector<uint32_t> m_firstTriangle; /// start of the triangles of every point
+            std::vector<uint32_t> m_triangles; /// triangles of every point
+            std::vector<PointKind> m_kinds; /// kind of every point
+        };
+
+        TriangleSimplifier::TriangleSimplifier(const std::vector<fvec3>& positions,
+                                               const std::vector<uint32_t>& indices)
+        {
+            // vertices with the same position share a point
+            std::vector<uint32_t> order(positions.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [&positions](uint32_t a, uint32_t b) {
+                const fvec3& p = positions[a];
+                const fvec3& q = positions[b];
+                return (p.x != q.x) ? (p.x < q.x) : (p.y != q.y) ? (p.y < q.y) : (p.z < q.z);
+            });
+
+            m_pointOf.resize(positions.size());
+            for( size_t i = 0; i < order.size(); ++i )
+            {
+                if( (i == 0) || !(positions[order[i]] == positions[order[i - 1]]) )
+                {
+                    m_points.push_back(positions[order[i]]);
+                }
+                m_pointOf[order[i]] = uint32_t(m_points.size() - 1);
+            }
+
+            // triangles without area in the topology are dropped
+            m_indices.reserve(indices.size());
+            for( size_t i = 0; i + 2 < indices.size(); i += 3 )
+            {
+                const uint32_t a = m_pointOf[indices[i]];
+                const uint32_t b = m_pointOf[indices[i + 1]];
+                const uint32_t c = m_pointOf[indices[i + 2]];
+                if( (a != b) && (b != c) && (a != c) )
+                {
+                    m_indices.insert(m_indices.end(), indices.begin() + i, indices.begin() + i + 3);
+                }
+            }
+
+            buildTopology();
+
+            // planes of the triangles, weighted by their area
+            m_quadrics.resize(m_points.size());
+            for( size_t i = 0; i < m_indices.size(); i += 3 )
+            {
+                const fvec3& a = m_points[m_pointOf[m_indices[i]]];
+                const fvec3& b = m_points[m_pointOf[m_indices[i + 1]]];
+                const fvec3& c = m_points[m_pointOf[m_indices[i + 2]]];
+
+                const fvec3 normal = cross(b - a, c - a);
+                const float area = length(normal) * 0.5f;
+                if( area <= 0.0f )
+                {
+                    continue;
+                }
+
+                Quadric quadric;
+                quadric.addPlane(normalize(normal), a, area);
+                for( size_t k = 0; k < 3; ++k )
+                {
+                    m_quadrics[m_pointOf[m_indices[i + k]]].add(quadric);
+                }
+            }
+
+            // planes through the borders and seams, perpendicular to their triangle
+            for( size_t i = 0; i < m_indices.size(); i += 3 )
+            {
+                for( size_t k = 0; k < 3; ++k )
+                {
+                    const uint32_t a = m_indices[i + k];
+                    const uint32_t b = m_indices[i + (k + 1) % 3];
+                    const uint32_t pa = m_pointOf[a], pb = m_pointOf[b];
+
+                    const bool border = !hasPointEdge(pb, pa);
+                    const bool seam = !border && !hasVertexEdge(b, a);
+                    if( !border && !seam )
+                    {
+                        continue;
+                    }
+
+                    const fvec3& c = m_points[m_pointOf[m_indices[i + (k + 2) % 3]]];
+                    const fvec3 edge = m_points[pb] - m_points[pa];
+                    const fvec3 normal = normalize(cross(edge, cross(edge, c - m_points[pa])));
+                    if( dot(normal, normal) == 0.0f )
+                    {
+                        continue;
+                    }
+
+                    Quadric quadric;
+                    quadric.addPlane(normal, m_points[pa],
+                                     dot(edge, edge) * (border ? kBorderWeight : kSeamWeight));
+                    m_quadrics[pa].add(quadric);
+                    m_quadrics[pb].add(quadric);
+                }
+            }
+        }
+
+        void TriangleSimplifier::forEachEdge(
+            const std::function<void(uint32_t, uint32_t, bool, bool)>& visit) const
+        {
+            for( size_t i = 0; i < m_indices.size(); i += 3 )
+            {
+                for( size_t k = 0; k < 3; ++k )
+                {
+                    const uint32_t a = m_indices[i + k];
+                    const uint32_t b = m_indices[i + (k + 1) % 3];
+
+                    // an edge is open when no triangle uses it in the other direction
+                    const bool border = !hasPointEdge(m_pointOf[b], m_pointOf[a]);
+                    const bool seam = !border && !hasVertexEdge(b, a);
+                    visit(a, b, border, seam);
+                }
+            }
+        }
+
+        void TriangleSimplifier::buildTopology()
+        {
+            const size_t pointsCount = m_points.size();
+
+            m_pointEdges.clear();
+            m_vertexEdges.clear();
+            for( size_t i = 0; i < m_indices.size(); i += 3 )
+            {
+                for( size_t k = 0; k < 3; ++k )
+                {
+                    const uint32_t a = m_indices[i + k];
+                    const uint32_t b = m_indices[i + (k + 1) % 3];
+                    m_pointEdges.push_back(edgeKey(m_pointOf[a], m_pointOf[b]));
+                    m_vertexEdges.push_back(edgeKey(a, b));
+                }
+            }
+            std::sort(m_pointEdges.begin(), m_pointEdges.end());
+            std::sort(m_vertexEdges.begin(), m_vertexEdges.end());
+
+            // triangles of every point
+            m_firstTriangle.assign(pointsCount + 1, 0);
+            for( const auto vertex : m_indices )
+            {
+                ++m_firstTriangle[m_pointOf[vertex] + 1];
+            }
+            std::partial_sum(m_firstTriangle.begin(), m_firstTriangle.end(),
+                             m_firstTriangle.begin());
+
+            m_triangles.resize(m_indices.size());
+            std::vector<uint32_t> next(m_firstTriangle.begin(), m_firstTriangle.end() - 1);
+            for( size_t i = 0; i < m_indices.size(); ++i )
+            {
+                m_triangles[next[m_pointOf[m_indices[i]]]++] = uint32_t(i / 3);
+            }
+
+            // vertices, open edges and seam edges of every point
+            std::vector<uint32_t> vertices(pointsCount, 0), borders(pointsCount, 0),
+                                  seams(pointsCount, 0);
+            std::vector<bool> counted(m_pointOf.size(), false);
+            for( const auto vertex : m_indices )
+            {
+                if( !counted[vertex] )
+                {
+                    counted[vertex] = true;
+                    ++vertices[m_pointOf[vertex]];
+                }
+            }
+
+            forEachEdge([&](uint32_t a, uint32_t b, bool border, bool seam) {
+                if( border )
+                {
+                    ++borders[m_pointOf[a]];
+                    ++borders[m_pointOf[b]];
+                }
+                else if( seam )
+                {
+                    ++seams[m_pointOf[a]];
+                    ++seams[m_pointOf[b]];
+                }
+            });
+
+            // a border point has an incoming and an outgoing open edge, a
+            // seam point has both on the two sides of the seam. Corners,
+            // seam ends and non manifold points are locked
+            m_kinds.resize(pointsCount);
+            for( size_t p = 0; p < pointsCount; ++p )
+            {
+                if( (vertices[p] == 1) && (borders[p] == 0) && (seams[p] == 0) )
+                {
+                    m_kinds[p] = Manifold;
+                }
+                else if( (vertices[p] == 1) && (borders[p] == 2) && (seams[p] == 0) )
+                {
+                    m_kinds[p] = Border;
+                }
+                else if( (vertices[p] == 2) && (borders[p] == 0) && (seams[p] == 4) )
+                {
+                    m_kinds[p] = Seam;
+                }
+                else
+                {
+                    m_kinds[p] = Locked;
+                }
+            }
+        }
+
+        size_t TriangleSimplifier::prepareCollapse(const Collapse& collapse,
+                                                   std::vector<uint32_t>& remap) const
+        {
+            const uint32_t kNone = uint32_t(-1);
+
+            // every vertex of from moves to the vertex of to from a triangle
+            // that contains both, so the attributes don't change
+            std::vector<std::pair<uint32_t, uint32_t>> moves;
+            size_t removed = 0;
+
+            for( uint32_t t = m_firstTriangle[collapse.from];
+                 t < m_firstTriangle[collapse.from + 1]; ++t )
+            {
+                const uint32_t* triangle = &m_indices[3 * m_triangles[t]];
+
+                uint32_t from = kNone, to = kNone;
+                for( size_t k = 0; k < 3; ++k )
+                {
+                    if( m_pointOf[triangle[k]] == collapse.from )
+                    {
+                        from = triangle[k];
+                    }
+                    else if( m_pointOf[triangle[k]] == collapse.to )
+                    {
+                        to = triangle[k];
+                    }
+                }
+
+                if( to == kNone )
+                {
+                    continue;
+                }
+
+                ++removed;
+                const auto move = std::find_if(moves.begin(), moves.end(),
+                                               [from](const std::pair<uint32_t, uint32_t>& m) {
+                                                   return m.first == from;
+                                               });
+                if( move == moves.end() )
+                {
+                    moves.push_back(std::make_pair(from, to));
+                }
+                else if( move->second != to )
+                {
+                    return 0;
+                }
+            }
+
+            for( uint32_t t = m_firstTriangle[collapse.from];
+                 t < m_firstTriangle[collapse.from + 1]; ++t )
+            {
+                const uint32_t* triangle = &m_indices[3 * m_triangles[t]];
+
+                fvec3 before[3], after[3];
+                bool removedTriangle = false;
+                for( size_t k = 0; k < 3; ++k )
+                {
+                    const uint32_t point = m_pointOf[triangle[k]];
+                    before[k] = after[k] = m_points[point];
+
+                    if( point == collapse.to )
+                    {
+                        removedTriangle = true;
+                    }
+                    else if( point == collapse.from )
+                    {
+                        after[k] = m_points[collapse.to];
+
+                        const uint32_t vertex = triangle[k];
+                        if( std::find_if(moves.begin(), moves.end(),
+                                         [vertex](const std::pair<uint32_t, uint32_t>& m) {
+                                             return m.first == vertex;
+                                         }) == moves.end() )
+                        {
+                            // a vertex of from has no matching vertex
+                            return 0;
+                        }
+                    }
+                }
+
+                if( removedTriangle )
+                {
+                    continue;
+                }
+
+                // the triangles that stay must not flip
+                const fvec3 normalBefore = cross(before[1] - before[0], before[2] - before[0]);
+                const fvec3 normalAfter = cross(after[1] - after[0], after[2] - after[0]);
+                if( (dot(normalBefore, normalBefore) > 0.0f) &&
+                    (dot(normalBefore, normalAfter) <= 0.0f) )
+                {
+                    return 0;
+                }
+            }
+
+            for( const auto& move : moves )
+            {
+                remap[move.first] = move.second;
+            }
+            return removed;
+        }
+
+        void TriangleSimplifier::simplify(size_t targetCount)
+        {
+            while( m_indices.size() / 3 > targetCount )
+            {
+                const size_t trianglesCount = m_indices.size() / 3;
+
+                // every pass removes a part of the triangles with the best
+                // collapses whose neighbourhoods don't overlap, then the
+                // collapses are evaluated again
+                const size_t goal = std::min(trianglesCount - targetCount,
+                                             std::max<size_t>(trianglesCount / 4, 1));
+
+                std::vector<Collapse> collapses;
+                forEachEdge([&](uint32_t a, uint32_t b, bool border, bool seam) {
+                    const uint32_t pa = m_pointOf[a], pb = m_pointOf[b];
+
+                    for( int direction = 0; direction < 2; ++direction )
+                    {
+                        Collapse collapse;
+                        collapse.from = direction ? pb : pa;
+                        collapse.to = direction ? pa : pb;
+
+                        const PointKind from = m_kinds[collapse.from];
+                        const PointKind to = m_kinds[collapse.to];
+                        const bool allowed = (from == Manifold) ||
+                            ((from == Border) && border && ((to == Border) || (to == Locked))) ||
+                            ((from == Seam) && seam && ((to == Seam) || (to == Locked)));
+                        if( !allowed )
+                        {
+                            continue;
+                        }
+
+                        collapse.error = m_quadrics[collapse.from].error(m_points[collapse.to]);
+                        collapses.push_back(collapse);
+                    }
+                });
+
+                std::sort(collapses.begin(), collapses.end(),
+                          [](const Collapse& a, const Collapse& b) {
+                              return a.error < b.error;
+                          });
+
+                std::vector<uint32_t> remap(m_pointOf.size());
+                std::iota(remap.begin(), remap.end(), 0);
+                std::vector<bool> locked(m_points.size(), false);
+                size_t removed = 0;
+
+                for( const auto& collapse : collapses )
+                {
+                    if( removed >= goal )
+                    {
+                        break;
+                    }
+
+                    if( locked[collapse.from] || locked[collapse.to] )
+                    {
+                        continue;
+                    }
+
+                    const size_t collapseRemoved = prepareCollapse(collapse, remap);
+                    if( collapseRemoved == 0 )
+                    {
+                        continue;
+                    }
+
+                    // the neighbourhood of from changes, it can't collapse again
+                    for( uint32_t t = m_firstTriangle[collapse.from];
+                         t < m_firstTriangle[collapse.from + 1]; ++t )
+                    {
+                        for( size_t k = 0; k < 3; ++k )
+                        {
+                            locked[m_pointOf[m_indices[3 * m_triangles[t] + k]]] = true;
+                        }
+                    }
+
+                    m_quadrics[collapse.to].add(m_quadrics[collapse.from]);
+                    m_error = std::max(m_error, collapse.error);
+                    removed += collapseRemoved;
+                }
+
+                if( removed == 0 )
+                {
+                    return;
+                }
+
+                // move the vertices and remove the triangles without area
+                size_t output = 0;
+                for( size_t i = 0; i < m_indices.size(); i += 3 )
+                {
+                    const uint32_t a = remap[m_indices[i]];
+                    const uint32_t b = remap[m_indices[i + 1]];
+                    const uint32_t c = remap[m_indices[i + 2]];
+                    if( (m_pointOf[a] == m_pointOf[b]) || (m_pointOf[b] == m_pointOf[c]) ||
+                        (m_pointOf[a] == m_pointOf[c]) )
+                    {
+                        continue;
+                    }
+
+                    m_indices[output++] = a;
+                    m_indices[output++] = b;
+                    m_indices[output++] = c;
+                }
+                m_indices.resize(output);
+
+                buildTopology();
+            }
+        }
+    }
+
+    void generateLods(VertexBuffer& buffer, const std::vector<float>& ratios)
+    {
+        assert( buffer.indexSize == 4 );
+        if( buffer.indexSize != 4 )
+        {
+            return;
+        }
+
+        buffer.lods.clear();
+
+        // finer levels first, every level simplifies the previous one
+        std::vector<float> levelRatios;
+        for( const auto ratio : ratios )
+        {
+            if( (ratio > 0.0f) && (ratio < 1.0f) )
+            {
+                levelRatios.push_back(ratio);
+            }
+        }
+        std::sort(levelRatios.begin(), levelRatios.end(), std::greater<float>());
+        if( levelRatios.empty() )
+        {
+            return;
+        }
+
+        const auto positions = vertexPositions(buffer);
+
+        // indices of every level, the Triangles commands of a level point
+        // inside them until they are appended to the buffer
+        std::vector<std::vector<uint32_t>> levelIndices(levelRatios.size());
+        std::vector<size_t> levelTriangles(levelRatios.size(), 0);
+        size_t trianglesCount = 0;
+        buffer.lods.resize(levelRatios.size());
+
+        for( const auto& command : buffer.commands )
+        {
+            if( command.type != Command::Triangles )
+            {
+                for( auto& lod : buffer.lods )
+                {
+                    lod.commands.push_back(command);
+                }
+                continue;
+            }
+
+            // the vertices of the command, numbered from 0
+            const uint32_t end = command.index + command.count - command.count % 3;
+            std::vector<uint32_t> indices(buffer.ibo.begin() + command.index,
+                                          buffer.ibo.begin() + end);
+            std::vector<uint32_t> vertices(indices);
+            std::sort(vertices.begin(), vertices.end());
+            vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+
+            std::vector<fvec3> commandPositions(vertices.size());
+            for( size_t v = 0; v < vertices.size(); ++v )
+            {
+                commandPositions[v] = positions[vertices[v] + command.baseVertex];
+            }
+            for( auto& index : indices )
+            {
+                index = uint32_t(std::lower_bound(vertices.begin(), vertices.end(), index) -
+                                 vertices.begin());
+            }
+
+            TriangleSimplifier simplifier(commandPositions, indices);
+            std::vector<fvec3> points;
+            trianglesCount += indices.size() / 3;
+
+            for( size_t level = 0; level < levelRatios.size(); ++level )
+            {
+                simplifier.simplify(size_t(levelRatios[level] * (indices.size() / 3) + 0.5f));
+
+                Command lodCommand = command;
+                lodCommand.index = uint32_t(levelIndices[level].size());
+                lodCommand.count = uint32_t(simplifier.indices().size());
+
+                points.clear();
+                for( const auto index : simplifier.indices() )
+                {
+                    levelIndices[level].push_back(vertices[index]);
+                    points.push_back(commandPositions[index]);
+                }
+
+                lodCommand.bounds = computeBounds(points.data(), points.size());
+                buffer.lods[level].commands.push_back(lodCommand);
+
+                levelTriangles[level] += simplifier.indices().size() / 3;
+                buffer.lods[level].error = std::max(buffer.lods[level].error,
+                                                    simplifier.error());
+            }
+        }
+
+        for( size_t level = 0; level < levelRatios.size(); ++level )
+        {
+            LodLevel& lod = buffer.lods[level];
+            const uint32_t offset = uint32_t(buffer.ibo.size());
+
+            for( auto& command : lod.commands )
+            {
+                if( command.type == Command::Triangles )
+                {
+                    command.index += offset;
+                }
+            }
+            buffer.ibo.insert(buffer.ibo.end(), levelIndices[level].begin(),
+                              levelIndices[level].end());
+
+            lod.ratio = (trianglesCount > 0) ? float(levelTriangles[level]) / trianglesCount
+                                             : 1.0f;
+        }
+    }
+
+    size_t selectLod(const VertexBuffer& buffer, float distance, float projectionScale,
+                     float maxPixelError)
+    {
+        // the errors grow with the level
+        size_t level = 0;
+        for( size_t i = 0; i < buffer.lods.size(); ++i )
+        {
+            const float pixels = buffer.lods[i].error * projectionScale /
+                                 std::max(distance, 1e-6f);
+            if( pixels > maxPixelError )
+            {
+                break;
+            }
+            level = i + 1;
+        }
+        return level;
+    }
+}
@@ -0,0 +1,57 @@
+//
+//  Simplifier.h
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#ifndef Simplifier_h
+#define Simplifier_h
+
+#include <vector>
+#include <cstddef>
+
+#include "IObject.h"
+
+namespace WavefrontFileReader
+{
+    /**
+     * Generate levels of detail of the Triangles commands, stored in
+     * @see VertexBuffer::lods. Triangles are removed by collapsing edges in
+     * the order of their quadric error (Garland and Heckbert). An edge
+     * collapses into one of its vertices, so the levels keep using the
+     * vertices of the buffer and only add indices.
+     *
+     * Vertices with the same position and different normals or texture
+     * coordinates (seams) only move along the seam, and open borders only
+     * along the border, so the texture mapping and the silhouette are kept.
+     * Other commands are copied unchanged in every level.
+     *
+     * Run it before the passes that reorder the indices, they also optimize
+     * the levels.
+     *
+     * @param buffer - buffer with 32 bits indices
+     * @param ratios - fraction of the triangles kept by every level. A level
+     *              may keep more triangles when the borders prevent it
+     */
+    void generateLods(VertexBuffer& buffer,
+                      const std::vector<float>& ratios = { 0.5f, 0.25f, 0.1f });
+
+    /**
+     * Select the coarsest level of detail whose error is smaller than a pixel
+     * threshold on the screen.
+     *
+     * @param buffer - buffer with levels of detail
+     * @param distance - distance between the camera and the object
+     * @param projectionScale - pixels covered by a model unit at distance 1,
+     *              viewport height / (2 * tan(vertical field of view / 2))
+     * @param maxPixelError - largest accepted error, in pixels
+     *
+     * @return Returns 0 for the full detail, level + 1 for buffer.lods[level]
+     */
+    size_t selectLod(const VertexBuffer& buffer, float distance, float projectionScale,
+                     float maxPixelError = 1.0f);
+}
+
+#endif /* Simplifier_h */
@@ -0,0 +1,416 @@
+//
+//  ThreadPool.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <algorithm>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace WavefrontFileReader
+{
+    /**
+     * Thread of the pool with its task queue
+     */
+    struct ThreadPool::Worker
+    {
+        std::mutex mutex; /// guards tasks
+        std::deque<std::function<void()>> tasks; /// the owner uses the back, thieves the front
+        std::thread thread;
+    };
+
+    /**
+     * State of the pool used by all the workers
+     */
+    struct ThreadPool::Shared
+    {
+        std::mutex mutex; /// guards queued and stop
+        std::condition_variable wake; /// signaled when a task is queued or the pool stops
+        size_t queued = 0; /// tasks in all the worker queues
+        bool stop = false; /// the workers exit when no task is left
+        std::atomic<unsigned> nextWorker; /// receives the next task from another thread
+
+        Shared() : nextWorker(0) {}
+    };
+
+    namespace
+    {
+        /// Pool and worker of the current thread, nullptr outside of the workers
+        thread_local ThreadPool* t_pool = nullptr;
+        thread_local unsigned t_worker = 0;
+
+        std::mutex g_sharedMutex; /// guards the shared pool
+        std::unique_ptr<ThreadPool> g_sharedPool;
+        ThreadPoolOptions g_sharedOptions;
+
+        /// Run a thread only on a processor
+        void pinThread(std::thread& thread, unsigned cpu)
+        {
+#if defined(__linux__)
+            if( cpu >= CPU_SETSIZE )
+            {
+                throw std::runtime_error("Invalid processor");
+            }
+
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            if( pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) != 0 )
+            {
+                throw std::runtime_error("Could not set the thread affinity");
+            }
+#else
+            (void)thread;
+            (void)cpu;
+#endif
+        }
+    }
+
+    ThreadPool::ThreadPool(const ThreadPoolOptions& options)
+    : m_shared(new Shared())
+    {
+        unsigned threadCount = options.threadCount;
+        if( threadCount == 0 )
+        {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        // every queue exists before a worker can steal from it
+        m_workers.reserve(threadCount);
+        for( unsigned i = 0; i < threadCount; ++i )
+        {
+            m_workers.push_back(std::unique_ptr<Worker>(new Worker()));
+        }
+
+        try
+        {
+            for( unsigned i = 0; i < threadCount; ++i )
+            {
+                m_workers[i]->thread = std::thread(&ThreadPool::run, this, i);
+                if( !options.cpus.empty() )
+                {
+                    pinThread(m_workers[i]->thread, options.cpus[i % options.cpus.size()]);
+                }
+            }
+        }
+        catch( ... )
+        {
+            stop();
+            throw;
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        stop();
+    }
+
+    void ThreadPool::stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_shared->mutex);
+            m_shared->stop = true;
+        }
+        m_shared->wake.notify_all();
+
+        for( auto& worker : m_workers )
+        {
+            if( worker->thread.joinable() )
+            {
+                worker->thread.join();
+            }
+        }
+    }
+
+    unsigned ThreadPool::threadCount() const
+    {
+        return unsigned(m_workers.size());
+    }
+
+    void ThreadPool::submit(std::function<void()> task)
+    {
+        // workers keep their tasks, they are likely to use the same memory
+        const unsigned index = (t_pool == this) ? t_worker
+                                                : m_shared->nextWorker++ % threadCount();
+
+        Worker& worker = *m_workers[index];
+        {
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.tasks.push_back(std::move(task));
+        }
+        notify();
+    }
+
+    void ThreadPool::notify()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_shared->mutex);
+            ++m_shared->queued;
+        }
+        m_shared->wake.notify_one();
+    }
+
+    bool ThreadPool::findTask(unsigned index, std::function<void()>& task)
+    {
+        const unsigned count = threadCount();
+        for( unsigned i = 0; i < count; ++i )
+        {
+            Worker& worker = *m_workers[(index + i) % count];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            if( worker.tasks.empty() )
+            {
+                continue;
+            }
+
+            // the newest task of its own queue, the oldest of the others
+            if( i == 0 )
+            {
+                task = std::move(worker.tasks.back());
+                worker.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(worker.tasks.front());
+                worker.tasks.pop_front();
+            }
+            return true;
+        }
+        return false;
+    }
+
+    void ThreadPool::run(unsigned index)
+    {
+        t_pool = this;
+        t_worker = index;
+
+        std::function<void()> task;
+        while( true )
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_shared->mutex);
+                m_shared->wake.wait(lock, [this]() {
+                    return m_shared->stop || (m_shared->queued > 0);
+                });
+                if( m_shared->queued == 0 )
+                {
+                    // stopped and every task was run
+                    return;
+                }
+                --m_shared->queued;
+            }
+
+            // a task is queued for every decrement, but another worker may
+            // take it first and leave this one the task counted for it
+            while( !findTask(index, task) )
+            {
+                std::this_thread::yield();
+            }
+
+            try
+            {
+                task();
+            }
+            catch( ... )
+            {
+                // submit doesn't report errors
+            }
+            task = nullptr;
+        }
+    }
+
+    void ThreadPool::parallelFor(size_t count, const std::function<void(size_t i)>& func,
+                                 unsigned maxThreads)
+    {
+        if( maxThreads == 0 )
+        {
+            maxThreads = threadCount();
+        }
+        const size_t threads = std::min<size_t>(maxThreads, count);
+
+        // indices have very different costs, every thread takes the next one
+        std::atomic<size_t> next(0);
+        auto loop = [&next, count, &func]() {
+            for( size_t i = next++; i < count; i = next++ )
+            {
+                func(i);
+            }
+        };
+
+        TaskGroup group(*this);
+        for( size_t i = 1; i < threads; ++i )
+        {
+            group.run(loop);
+        }
+
+        // the calling thread runs indices too
+        std::exception_ptr error;
+        try
+        {
+            loop();
+        }
+        catch( ... )
+        {
+            error = std::current_exception();
+            next = count;
+        }
+
+        group.wait();
+        if( error )
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    ThreadPool& ThreadPool::shared()
+    {
+        std::lock_guard<std::mutex> lock(g_sharedMutex);
+        if( !g_sharedPool )
+        {
+            g_sharedPool.reset(new ThreadPool(g_sharedOptions));
+        }
+        return *g_sharedPool;
+    }
+
+    void ThreadPool::configureShared(const ThreadPoolOptions& options)
+    {
+        std::unique_ptr<ThreadPool> previous;
+        {
+            std::lock_guard<std::mutex> lock(g_sharedMutex);
+            g_sharedOptions = options;
+            previous = std::move(g_sharedPool);
+        }
+    }
+
+    /**
+     * Tasks of a group that didn't start yet. Every task has a matching pool
+     * task that runs the oldest one, or nothing when the waiting thread
+     * already ran it.
+     */
+    struct TaskGroup::State
+    {
+        std::mutex mutex; /// guards all the members
+        std::condition_variable changed; /// a task was queued or the last one finished
+        std::deque<std::function<void()>> tasks; /// not started yet
+        size_t pending = 0; /// tasks queued or running
+        std::exception_ptr error; /// first exception thrown by a task
+
+        /**
+         * Run the oldest task that didn't start
+         * @return false when no task is left
+         */
+        bool runTask()
+        {
+            std::function<void()> task;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if( tasks.empty() )
+                {
+                    return false;
+                }
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+
+            std::exception_ptr taskError;
+            try
+            {
+                task();
+            }
+            catch( ... )
+            {
+                taskError = std::current_exception();
+            }
+
+            bool finished = false;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if( taskError && !error )
+                {
+                    error = taskError;
+                }
+                finished = (--pending == 0);
+            }
+            if( finished )
+            {
+                changed.notify_all();
+            }
+            return true;
+        }
+    };
+
+    TaskGroup::TaskGroup(ThreadPool& pool)
+    : m_pool(pool), m_state(std::make_shared<State>())
+    {
+    }
+
+    TaskGroup::~TaskGroup()
+    {
+        try
+        {
+            wait();
+        }
+        catch( ... )
+        {
+        }
+    }
+
+    void TaskGroup::run(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_state->mutex);
+            m_state->tasks.push_back(std::move(task));
+            ++m_state->pending;
+        }
+        m_state->changed.notify_all();
+
+        // keeps the state alive when it runs after the group is gone
+        std::shared_ptr<State> state = m_state;
+        m_pool.submit([state]() { state->runTask(); });
+    }
+
+    void TaskGroup::wait()
+    {
+        // only the tasks of this group are run here, waiting can't be
+        // delayed by unrelated work
+        while( true )
+        {
+            while( m_state->runTask() )
+            {
+            }
+
+            std::unique_lock<std::mutex> lock(m_state->mutex);
+            m_state->changed.wait(lock, [this]() {
+                return (m_state->pending == 0) || !m_state->tasks.empty();
+            });
+            if( m_state->pending == 0 )
+            {
+                break;
+            }
+        }
+
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock(m_state->mutex);
+            std::swap(error, m_state->error);
+        }
+        if( error )
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
@@ -0,0 +1,142 @@
+//
+//  ThreadPool.h
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#ifndef ThreadPool_h
+#define ThreadPool_h
+
+#include <memory>
+#include <vector>
+#include <functional>
+#include <cstddef>
+
+namespace WavefrontFileReader
+{
+    /**
+     * Options of a @see ThreadPool
+     */
+    struct ThreadPoolOptions
+    {
+        unsigned threadCount = 0; /// worker threads, 0 for hardware threads
+
+        /// Worker i runs only on the processor cpus[i % cpus.size()]. No
+        /// affinity when empty. Ignored where threads can't be pinned, like iOS
+        std::vector<unsigned> cpus;
+    };
+
+    /**
+     * Work stealing scheduler. Every worker has its own queue: tasks submitted
+     * by a worker go to its queue and are run newest first, idle workers
+     * steal the oldest tasks of the others. Tasks submitted by other threads
+     * are spread over the workers.
+     *
+     * The loader and the mesh processing stages share a single pool, @see
+     * shared, so nested parallel stages don't start more threads than the
+     * machine has.
+     */
+    class ThreadPool
+    {
+    public:
+        /**
+         * Start the worker threads
+         * @throw std::runtime_error if a processor of the affinity doesn't exist
+         */
+        explicit ThreadPool(const ThreadPoolOptions& options = ThreadPoolOptions());
+
+        /// Run the queued tasks and join the workers
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator= (const ThreadPool&) = delete;
+
+        /// Number of worker threads
+        unsigned threadCount() const;
+
+        /**
+         * Run a task on a worker. Exceptions thrown by the task are lost, use
+         * a @see TaskGroup to get them
+         */
+        void submit(std::function<void()> task);
+
+        /**
+         * Call func for every index from 0 to count. The calling thread runs
+         * indices too, the function returns after the last one.
+         *
+         * @param maxThreads - maximum number of threads running func,
+         *              including the calling thread. 0 for the pool threads
+         * @throw the first exception thrown by func
+         */
+        void parallelFor(size_t count, const std::function<void(size_t i)>& func,
+                         unsigned maxThreads = 0);
+
+        /**
+         * Pool used by the whole library. Created at the first call with
+         * the options from @see configureShared
+         */
+        static ThreadPool& shared();
+
+        /**
+         * Options of the shared pool. The pool is started again with them
+         * at the next call of @see shared; the tasks already submitted are
+         * finished first, so no stage may be running.
+         */
+        static void configureShared(const ThreadPoolOptions& options);
+
+    private:
+        struct Worker;
+
+        /// Worker thread loop
+        void run(unsigned index);
+
+        /// Take a task from the worker queue or steal one
+        bool findTask(unsigned index, std::function<void()>& task);
+
+        /// Wake a worker after a task was queued
+        void notify();
+
+        /// Run the queued tasks and join the started workers
+        void stop();
+
+        struct Shared;
+        std::unique_ptr<Shared> m_shared; /// sleeping and stopping
+        std::vector<std::unique_ptr<Worker>> m_workers; /// one queue for every thread
+    };
+
+    /**
+     * Tasks that are waited together. The thread that waits runs the group
+     * tasks that didn't start yet, so groups can be nested in tasks without
+     * blocking the workers.
+     */
+    class TaskGroup
+    {
+    public:
+        explicit TaskGroup(ThreadPool& pool = ThreadPool::shared());
+
+        /// Wait for the tasks, their exceptions are lost
+        ~TaskGroup();
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator= (const TaskGroup&) = delete;
+
+        /// Queue a task of the group
+        void run(std::function<void()> task);
+
+        /**
+         * Wait until every task of the group finished
+         * @throw the first exception thrown by a task
+         */
+        void wait();
+
+    private:
+        struct State;
+
+        ThreadPool& m_pool; /// runs the tasks
+        std::shared_ptr<State> m_state; /// shared with the queued tasks
+    };
+}
+
+#endif /* ThreadPool_h */
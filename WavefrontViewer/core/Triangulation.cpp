@@ -0,0 +1,109 @@
+//
+//  Triangulation.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include "Triangulation.h"
+
+#include <cassert>
+#include <vector>
+
+namespace WavefrontFileReader
+{
+    void triangulateQuads(VertexBuffer& buffer)
+    {
+        assert( buffer.indexSize == 4 );
+        if( buffer.indexSize != 4 )
+        {
+            return;
+        }
+
+        const auto& ibo = buffer.ibo;
+
+        // the first index of every quad. Levels of detail share the Quads
+        // ranges of the full detail
+        std::vector<bool> quadStart(ibo.size(), false);
+        bool hasQuads = false;
+
+        auto findQuads = [&](const std::vector<Command>& commands) {
+            for( const auto& command : commands )
+            {
+                if( command.type != Command::Quads )
+                {
+                    continue;
+                }
+
+                for( uint32_t i = 0; i + 4 <= command.count; i += 4 )
+                {
+                    quadStart[command.index + i] = true;
+                    hasQuads = true;
+                }
+            }
+        };
+
+        findQuads(buffer.commands);
+        for( const auto& lod : buffer.lods )
+        {
+            findQuads(lod.commands);
+        }
+
+        if( !hasQuads )
+        {
+            return;
+        }
+
+        // new position of every index
+        std::vector<uint32_t> position(ibo.size() + 1);
+        std::vector<uint32_t> triangles;
+        triangles.reserve(ibo.size() * 3 / 2);
+
+        for( size_t i = 0; i < ibo.size(); )
+        {
+            position[i] = uint32_t(triangles.size());
+
+            if( !quadStart[i] )
+            {
+                triangles.push_back(ibo[i++]);
+                continue;
+            }
+
+            triangles.push_back(ibo[i]);
+            triangles.push_back(ibo[i + 1]);
+            triangles.push_back(ibo[i + 2]);
+            triangles.push_back(ibo[i]);
+            triangles.push_back(ibo[i + 2]);
+            triangles.push_back(ibo[i + 3]);
+
+            position[i + 1] = position[i + 2] = position[i + 3] = position[i];
+            i += 4;
+        }
+        position[ibo.size()] = uint32_t(triangles.size());
+
+        auto moveCommands = [&position](std::vector<Command>& commands) {
+            for( auto& command : commands )
+            {
+                const uint32_t end = position[command.index + command.count];
+                command.index = position[command.index];
+                command.count = end - command.index;
+                command.type = Command::Triangles;
+            }
+        };
+
+        moveCommands(buffer.commands);
+        for( auto& lod : buffer.lods )
+        {
+            moveCommands(lod.commands);
+        }
+
+        // meshlets only split Triangles commands, their indices just move
+        for( auto& meshlet : buffer.meshlets )
+        {
+            meshlet.index = position[meshlet.index];
+        }
+
+        buffer.ibo.swap(triangles);
+    }
+}
@@ -0,0 +1,30 @@
+//
+//  Triangulation.h
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#ifndef Triangulation_h
+#define Triangulation_h
+
+#include "IObject.h"
+
+namespace WavefrontFileReader
+{
+    /**
+     * Replace the Quads commands with Triangles commands that draw the same
+     * quads, split like splitInTriangles does: 1 2 3 4 --> (1 2 3) (1 3 4).
+     * OpenGL ES has no quads, and neither fans nor strips draw several
+     * quads in a single call without as many indices as a triangle list.
+     *
+     * The indices of the other commands move after the new triangles, the
+     * commands, levels of detail and meshlets point to their new place.
+     *
+     * @param buffer - buffer with 32 bits indices
+     */
+    void triangulateQuads(VertexBuffer& buffer);
+}
+
+#endif /* Triangulation_h */
@@ -0,0 +1,148 @@
+//
+//  VertexDedupTable.h
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#ifndef VertexDedupTable_h
+#define VertexDedupTable_h
+
+#include <vector>
+#include <cinttypes>
+#include <cstddef>
+
+#include "types.h"
+
+namespace WavefrontFileReader
+{
+    /**
+     * Maps face corners (@see IndexData) to their position in the vertex
+     * buffer. Flat open addressing hash table with linear probing: the slots
+     * are stored in a single array and a lookup usually touches a single
+     * cache line.
+     *
+     * Keys must have vertexIndex > 0, a zero vertexIndex marks an empty slot.
+     */
+    class VertexDedupTable
+    {
+    public:
+        /**
+         * @param expectedCount - expected number of unique keys. The table
+         *              grows if more keys are inserted
+         */
+        explicit VertexDedupTable(size_t expectedCount = 0)
+        {
+            size_t capacity = 16;
+            while( capacity * kMaxLoad < expectedCount * 4 )
+            {
+                capacity *= 2;
+            }
+            m_slots.resize(capacity);
+        }
+
+        /**
+         * Find key in table and add it when it doesn't exist
+         *
+         * @param key - face corner
+         * @param value - value stored when the key is not found
+         * @param inserted - set to true when the key was added
+         *
+         * @return The value associated with the key
+         */
+        uint32_t insert(const IndexData& key, uint32_t value, bool& inserted)
+        {
+            if( (m_size + 1) * 4 > m_slots.size() * kMaxLoad )
+            {
+                grow();
+            }
+
+            const size_t mask = m_slots.size() - 1;
+            for( size_t i = hash(key) & mask; ; i = (i + 1) & mask )
+            {
+                Slot& slot = m_slots[i];
+
+                if( slot.key.vertexIndex == 0 )
+                {
+                    slot.key = key;
+                    slot.value = value;
+                    ++m_size;
+                    inserted = true;
+                    return value;
+                }
+
+                if( slot.key == key )
+                {
+                    inserted = false;
+                    return slot.value;
+                }
+            }
+        }
+
+        /// Number of keys in table
+        size_t size() const { return m_size; }
+
+        /// Number of bytes allocated by the table
+        size_t memoryUsage() const { return m_slots.capacity() * sizeof(Slot); }
+
+        /**
+         * Mix the three indices so that permutations of the same values
+         * (1/2/3, 3/2/1 ...) and neighbour corners land in different slots
+         */
+        static uint64_t hash(const IndexData& key)
+        {
+            uint64_t h = uint64_t(uint32_t(key.vertexIndex)) * 0x9E3779B97F4A7C15ull;
+            h ^= uint64_t(uint32_t(key.textureIndex)) * 0xC2B2AE3D27D4EB4Full;
+            h ^= uint64_t(uint32_t(key.normalIndex)) * 0x165667B19E3779F9ull;
+
+            // murmur3 finalizer
+            h ^= h >> 33;
+            h *= 0xFF51AFD7ED558CCDull;
+            h ^= h >> 33;
+            h *= 0xC4CEB9FE1A85EC53ull;
+            h ^= h >> 33;
+            return h;
+        }
+
+    private:
+        /// Maximum load factor, in quarters. Linear probing degrades above it
+        static const size_t kMaxLoad = 3;
+
+        struct Slot
+        {
+            IndexData key; /// face corner, vertexIndex is 0 for empty slots
+            uint32_t value = 0; /// position in vertex buffer
+        };
+
+        /// Double the capacity and reinsert all the keys
+        void grow()
+        {
+            std::vector<Slot> slots(m_slots.size() * 2);
+            const size_t mask = slots.size() - 1;
+
+            for( const auto& slot : m_slots )
+            {
+                if( slot.key.vertexIndex == 0 )
+                {
+                    continue;
+                }
+
+                size_t i = hash(slot.key) & mask;
+                while( slots[i].key.vertexIndex != 0 )
+                {
+                    i = (i + 1) & mask;
+                }
+                slots[i] = slot;
+            }
+
+            m_slots.swap(slots);
+        }
+
+    private:
+        std::vector<Slot> m_slots; /// capacity is always a power of two
+        size_t m_size = 0; /// number of keys in table
+    };
+}
+
+#endif /* VertexDedupTable_h */
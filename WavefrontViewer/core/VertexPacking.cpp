@@ -0,0 +1,356 @@
+//
+//  VertexPacking.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include "VertexPacking.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+namespace WavefrontFileReader
+{
+    namespace
+    {
+        /**
+         * Vertex in the Normalized16 and HalfFloat formats
+         */
+        struct PackedVertex
+        {
+            uint16_t position[4]; /// x, y, z and padding
+            int16_t normal[2]; /// octahedral coordinates, snorm
+            uint16_t texture[2]; /// u, v
+        };
+
+        static_assert(sizeof(PackedVertex) == 16, "Packed vertex must have 16 bytes");
+
+        const float kMaxUnsignedShort = 65535.0f;
+        const float kMaxShort = 32767.0f;
+
+        /// Map value from [offset, offset + scale] to [0, 65535]
+        uint16_t quantize(float value, float offset, float scale)
+        {
+            if( scale <= 0.0f )
+            {
+                return 0;
+            }
+
+            const float normalized = std::min(1.0f, std::max(0.0f, (value - offset) / scale));
+            return uint16_t(normalized * kMaxUnsignedShort + 0.5f);
+        }
+
+        /// Snorm to [-1, 1]
+        float fromSnorm(int16_t value)
+        {
+            return std::max(-1.0f, value / kMaxShort);
+        }
+
+        /// Value with the sign of reference, 1 for zero
+        float signOf(float reference, float value)
+        {
+            return (reference >= 0.0f) ? value : -value;
+        }
+
+        /// Smallest and largest value of the attribute component in all the vertices
+        void componentBounds(const std::vector<Vertex>& vbo, fvec3 Vertex::* attribute,
+                             float fvec3::* component, float& low, float& high)
+        {
+            low = high = 0.0f;
+            if( vbo.empty() )
+            {
+                return;
+            }
+
+            low = high = (vbo.front().*attribute).*component;
+            for( const auto& vertex : vbo )
+            {
+                const float value = (vertex.*attribute).*component;
+                low = std::min(low, value);
+                high = std::max(high, value);
+            }
+        }
+
+        /// Layout of the packed formats
+        VertexLayout packedLayout(VertexLayout::Format format)
+        {
+            const bool normalized = (format == VertexLayout::Normalized16);
+            const auto type = normalized ? VertexLayout::UnsignedShort : VertexLayout::Half;
+
+            VertexLayout layout;
+            layout.format = format;
+            layout.stride = sizeof(PackedVertex);
+            layout.octahedralNormals = true;
+
+            layout.position.type = type;
+            layout.position.components = 3;
+            layout.position.normalized = normalized;
+            layout.position.offset = offsetof(PackedVertex, position);
+
+            layout.normal.type = VertexLayout::Short;
+            layout.normal.components = 2;
+            layout.normal.normalized = true;
+            layout.normal.offset = offsetof(PackedVertex, normal);
+
+            layout.texture.type = type;
+            layout.texture.components = 2;
+            layout.texture.normalized = normalized;
+            layout.texture.offset = offsetof(PackedVertex, texture);
+
+            return layout;
+        }
+    }
+
+    uint16_t floatToHalf(float value)
+    {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+
+        const uint16_t sign = uint16_t((bits >> 16) & 0x8000);
+        const int exponent = int((bits >> 23) & 0xFF);
+        uint32_t mantissa = bits & 0x7FFFFF;
+
+        if( exponent == 0xFF )
+        {
+            // infinity stays infinity, nan stays nan
+            return sign | 0x7C00 | (mantissa ? 0x200 : 0);
+        }
+
+        const int halfExponent = exponent - 127 + 15;
+        if( halfExponent >= 31 )
+        {
+            return sign | 0x7C00;
+        }
+
+        if( halfExponent <= 0 )
+        {
+            // subnormal half or zero
+            if( halfExponent < -10 )
+            {
+                return sign;
+            }
+
+            mantissa |= 0x800000;
+            const int shift = 14 - halfExponent;
+            uint32_t half = mantissa >> shift;
+            const uint32_t remainder = mantissa & ((1u << shift) - 1);
+            const uint32_t halfway = 1u << (shift - 1);
+            if( (remainder > halfway) || ((remainder == halfway) && (half & 1)) )
+            {
+                ++half;
+            }
+            return sign | uint16_t(half);
+        }
+
+        // a carry from the mantissa correctly increments the exponent
+        uint32_t half = (uint32_t(halfExponent) << 10) | (mantissa >> 13);
+        const uint32_t remainder = mantissa & 0x1FFF;
+        if( (remainder > 0x1000) || ((remainder == 0x1000) && (half & 1)) )
+        {
+            ++half;
+        }
+        return sign | uint16_t(half);
+    }
+
+    float halfToFloat(uint16_t value)
+    {
+        const uint32_t sign = uint32_t(value & 0x8000) << 16;
+        const uint32_t exponent = (value >> 10) & 0x1F;
+        const uint32_t mantissa = value & 0x3FF;
+
+        if( exponent == 0 )
+        {
+            const float result = std::ldexp(float(mantissa), -24);
+            return sign ? -result : result;
+        }
+
+        const uint32_t bits = sign | ((exponent == 31) ? 0x7F800000 : ((exponent + 112) << 23)) |
+                              (mantissa << 13);
+        float result;
+        memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+
+    void encodeOctahedral(const fvec3& normal, int16_t& x, int16_t& y)
+    {
+        const float length = std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z);
+        if( length == 0.0f )
+        {
+            x = y = 0;
+            return;
+        }
+
+        float u = normal.x / length;
+        float v = normal.y / length;
+        if( normal.z < 0.0f )
+        {
+            // fold the lower half over the diagonals
+            const float foldedU = signOf(u, 1.0f - std::fabs(v));
+            const float foldedV = signOf(v, 1.0f - std::fabs(u));
+            u = foldedU;
+            v = foldedV;
+        }
+
+        x = int16_t(std::round(std::min(1.0f, std::max(-1.0f, u)) * kMaxShort));
+        y = int16_t(std::round(std::min(1.0f, std::max(-1.0f, v)) * kMaxShort));
+    }
+
+    fvec3 decodeOctahedral(int16_t x, int16_t y)
+    {
+        fvec3 normal(fromSnorm(x), fromSnorm(y), 0.0f);
+        normal.z = 1.0f - std::fabs(normal.x) - std::fabs(normal.y);
+
+        if( normal.z < 0.0f )
+        {
+            const float u = normal.x;
+            normal.x = signOf(u, 1.0f - std::fabs(normal.y));
+            normal.y = signOf(normal.y, 1.0f - std::fabs(u));
+        }
+
+        const float length = std::sqrt(normal.x * normal.x + normal.y * normal.y +
+                                       normal.z * normal.z);
+        normal.x /= length;
+        normal.y /= length;
+        normal.z /= length;
+        return normal;
+    }
+
+    void packVertices(VertexBuffer& buffer, VertexLayout::Format format)
+    {
+        if( (format == VertexLayout::Float32) ||
+            (buffer.layout.format != VertexLayout::Float32) )
+        {
+            return;
+        }
+
+        const auto& vbo = buffer.vbo;
+        VertexLayout layout = packedLayout(format);
+
+        fvec3 positionLow, positionHigh, textureLow, textureHigh;
+        componentBounds(vbo, &Vertex::position, &fvec3::x, positionLow.x, positionHigh.x);
+        componentBounds(vbo, &Vertex::position, &fvec3::y, positionLow.y, positionHigh.y);
+        componentBounds(vbo, &Vertex::position, &fvec3::z, positionLow.z, positionHigh.z);
+        componentBounds(vbo, &Vertex::texture, &fvec3::x, textureLow.x, textureHigh.x);
+        componentBounds(vbo, &Vertex::texture, &fvec3::y, textureLow.y, textureHigh.y);
+
+        if( format == VertexLayout::Normalized16 )
+        {
+            layout.positionOffset = positionLow;
+            layout.positionScale = fvec3(positionHigh.x - positionLow.x,
+                                         positionHigh.y - positionLow.y,
+                                         positionHigh.z - positionLow.z);
+            layout.textureOffset = fvec3(textureLow.x, textureLow.y, 0.0f);
+            layout.textureScale = fvec3(textureHigh.x - textureLow.x,
+                                        textureHigh.y - textureLow.y, 0.0f);
+        }
+        else
+        {
+            // half floats are most precise around zero
+            layout.positionOffset = fvec3((positionLow.x + positionHigh.x) * 0.5f,
+                                          (positionLow.y + positionHigh.y) * 0.5f,
+                                          (positionLow.z + positionHigh.z) * 0.5f);
+        }
+
+        const fvec3& offset = layout.positionOffset;
+        const fvec3& scale = layout.positionScale;
+        const fvec3& textureOffset = layout.textureOffset;
+        const fvec3& textureScale = layout.textureScale;
+
+        std::vector<uint8_t> packed(vbo.size() * sizeof(PackedVertex));
+        PackedVertex* output = reinterpret_cast<PackedVertex*>(packed.data());
+
+        for( const auto& vertex : vbo )
+        {
+            PackedVertex& result = *output++;
+
+            if( format == VertexLayout::Normalized16 )
+            {
+                result.position[0] = quantize(vertex.position.x, offset.x, scale.x);
+                result.position[1] = quantize(vertex.position.y, offset.y, scale.y);
+                result.position[2] = quantize(vertex.position.z, offset.z, scale.z);
+                result.texture[0] = quantize(vertex.texture.x, textureOffset.x, textureScale.x);
+                result.texture[1] = quantize(vertex.texture.y, textureOffset.y, textureScale.y);
+            }
+            else
+            {
+                result.position[0] = floatToHalf(vertex.position.x - offset.x);
+                result.position[1] = floatToHalf(vertex.position.y - offset.y);
+                result.position[2] = floatToHalf(vertex.position.z - offset.z);
+                result.texture[0] = floatToHalf(vertex.texture.x);
+                result.texture[1] = floatToHalf(vertex.texture.y);
+            }
+            result.position[3] = 0;
+
+            encodeOctahedral(vertex.normal, result.normal[0], result.normal[1]);
+        }
+
+        buffer.packedVbo.swap(packed);
+        buffer.vbo = std::vector<Vertex>();
+        buffer.layout = layout;
+    }
+
+    std::vector<Vertex> unpackVertices(const VertexBuffer& buffer)
+    {
+        const VertexLayout& layout = buffer.layout;
+        if( layout.format == VertexLayout::Float32 )
+        {
+            return buffer.vbo;
+        }
+
+        const bool normalized = (layout.format == VertexLayout::Normalized16);
+        auto decode = [normalized](uint16_t value, float offset, float scale) {
+            const float stored = normalized ? value / kMaxUnsignedShort : halfToFloat(value);
+            return offset + stored * scale;
+        };
+
+        const size_t count = buffer.verticesCount();
+        const PackedVertex* input = reinterpret_cast<const PackedVertex*>(buffer.packedVbo.data());
+
+        std::vector<Vertex> vertices(count);
+        for( size_t i = 0; i < count; ++i )
+        {
+            const PackedVertex& packed = input[i];
+            Vertex& vertex = vertices[i];
+
+            const fvec3& offset = layout.positionOffset;
+            const fvec3& scale = layout.positionScale;
+            vertex.position.x = decode(packed.position[0], offset.x, scale.x);
+            vertex.position.y = decode(packed.position[1], offset.y, scale.y);
+            vertex.position.z = decode(packed.position[2], offset.z, scale.z);
+
+            vertex.texture.x = decode(packed.texture[0], layout.textureOffset.x,
+                                      layout.textureScale.x);
+            vertex.texture.y = decode(packed.texture[1], layout.textureOffset.y,
+                                      layout.textureScale.y);
+
+            // zero normals can't be represented, they come back as (0, 0, 1)
+            vertex.normal = decodeOctahedral(packed.normal[0], packed.normal[1]);
+        }
+        return vertices;
+    }
+
+    std::vector<fvec3> vertexPositions(const VertexBuffer& buffer)
+    {
+        std::vector<fvec3> positions;
+        if( buffer.layout.format == VertexLayout::Float32 )
+        {
+            positions.reserve(buffer.vbo.size());
+            for( const auto& vertex : buffer.vbo )
+            {
+                positions.push_back(vertex.position);
+            }
+        }
+        else
+        {
+            for( const auto& vertex : unpackVertices(buffer) )
+            {
+                positions.push_back(vertex.position);
+            }
+        }
+        return positions;
+    }
+}
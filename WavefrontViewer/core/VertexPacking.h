@@ -0,0 +1,60 @@
+//
+//  VertexPacking.h
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#ifndef VertexPacking_h
+#define VertexPacking_h
+
+#include <vector>
+#include <cinttypes>
+
+#include "IObject.h"
+
+namespace WavefrontFileReader
+{
+    /**
+     * Convert the Float32 vertices of the buffer to a compact format. The
+     * packed vertices replace the Float32 ones and the buffer layout
+     * describes how to decode them.
+     *
+     * @param buffer - buffer with Float32 vertices
+     * @param format - new vertex format. Nothing is changed for Float32
+     */
+    void packVertices(VertexBuffer& buffer, VertexLayout::Format format);
+
+    /**
+     * Decode the vertices of a buffer, whatever their format
+     * @param buffer - buffer with vertices in any format
+     * @return Decoded vertices. Packed vertices lose precision
+     */
+    std::vector<Vertex> unpackVertices(const VertexBuffer& buffer);
+
+    /// Positions of all the vertices of a buffer, whatever their format
+    std::vector<fvec3> vertexPositions(const VertexBuffer& buffer);
+
+    /// Convert to half float, rounding to nearest even
+    uint16_t floatToHalf(float value);
+
+    /// Convert from half float
+    float halfToFloat(uint16_t value);
+
+    /**
+     * Octahedral encoding of a normal: the unit sphere is projected on an
+     * octahedron which is unfolded in the [-1, 1] square
+     *
+     * @param normal - normal to encode, doesn't need to be normalized. Zero
+     *              normals are encoded as (0, 0, 1)
+     * @param x - receives the first coordinate as 16 bits snorm
+     * @param y - receives the second coordinate as 16 bits snorm
+     */
+    void encodeOctahedral(const fvec3& normal, int16_t& x, int16_t& y);
+
+    /// Unit normal from octahedral coordinates, @see encodeOctahedral
+    fvec3 decodeOctahedral(int16_t x, int16_t y);
+}
+
+#endif /* VertexPacking_h */
@@ -0,0 +1,236 @@
+//
+//  VertexWelder.cpp
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#include "VertexWelder.h"
+
+#include <algorithm>
+
+#include "VertexDedupTable.h"
+
+namespace WavefrontFileReader
+{
+    namespace
+    {
+        /// Maximum number of bits sorted by a radix pass
+        const unsigned kMaxRadixBits = 16;
+
+        /**
+         * Corner key, up to 96 bits, and the corner number
+         */
+        struct SortItem
+        {
+            uint64_t low = 0; /// key bits 0..63
+            uint32_t high = 0; /// key bits 64..95
+            uint32_t corner = 0; /// corner number
+        };
+
+        /// Number of bits needed to store value
+        inline unsigned bitWidth(uint32_t value)
+        {
+            return (value == 0) ? 0 : unsigned(32 - __builtin_clz(value));
+        }
+
+        /// Store value in key starting with bit offset
+        inline void pack(SortItem& item, uint32_t value, unsigned offset)
+        {
+            if( offset >= 64 )
+            {
+                item.high |= value << (offset - 64);
+                return;
+            }
+
+            item.low |= uint64_t(value) << offset;
+            if( offset > 32 )
+            {
+                item.high |= value >> (64 - offset);
+            }
+        }
+
+        /// Key bits shift..shift+bits, masked with mask
+        inline uint32_t digit(const SortItem& item, unsigned shift, uint32_t mask)
+        {
+            if( shift >= 64 )
+            {
+                return (item.high >> (shift - 64)) & mask;
+            }
+
+            uint64_t bits = item.low >> shift;
+            if( shift > 32 )
+            {
+                bits |= uint64_t(item.high) << (64 - shift);
+            }
+            return uint32_t(bits) & mask;
+        }
+
+        /// Number of corners from all the segments
+        size_t cornersCount(const CornerSegments& corners)
+        {
+            size_t count = 0;
+            for( const auto& segment : corners )
+            {
+                count += segment.size();
+            }
+            return count;
+        }
+    }
+
+    void weldWithHash(const CornerSegments& corners, size_t expectedCount,
+                      WeldResult& result)
+    {
+        result.vertexOfCorner.clear();
+        result.vertices.clear();
+        result.vertexOfCorner.reserve(cornersCount(corners));
+        result.vertices.reserve(expectedCount);
+
+        VertexDedupTable table(expectedCount);
+
+        for( const auto& segment : corners )
+        {
+            for( const auto& index : segment )
+            {
+                bool inserted = false;
+                const uint32_t vertex = table.insert(index,
+                                                     (uint32_t)result.vertices.size(),
+                                                     inserted);
+                if( inserted )
+                {
+                    result.vertices.push_back(index);
+                }
+
+                result.vertexOfCorner.push_back(vertex);
+            }
+        }
+    }
+
+    void weldWithSort(const CornerSegments& corners, WeldResult& result)
+    {
+        const size_t count = cornersCount(corners);
+
+        result.vertexOfCorner.clear();
+        result.vertices.clear();
+
+        // keys only use the bits needed by the largest indices. Negative
+        // (relative) indices are kept as they are and use all 32 bits
+        uint32_t vertexBits = 0, textureBits = 0, normalBits = 0;
+        for( const auto& segment : corners )
+        {
+            for( const auto& index : segment )
+            {
+                vertexBits |= uint32_t(index.vertexIndex);
+                textureBits |= uint32_t(index.textureIndex);
+                normalBits |= uint32_t(index.normalIndex);
+            }
+        }
+
+        const unsigned normalOffset = 0;
+        const unsigned textureOffset = normalOffset + bitWidth(normalBits);
+        const unsigned vertexOffset = textureOffset + bitWidth(textureBits);
+        const unsigned keyBits = vertexOffset + bitWidth(vertexBits);
+
+        // the key is split in digits of equal size, as few as possible
+        const unsigned passes = (keyBits + kMaxRadixBits - 1) / kMaxRadixBits;
+        const unsigned radixBits = (passes == 0) ? 0 : (keyBits + passes - 1) / passes;
+        const uint32_t radixMask = (1u << radixBits) - 1;
+
+        // the histograms of all the passes are computed while the keys are built
+        std::vector<std::vector<uint32_t>> histograms(passes,
+                                                      std::vector<uint32_t>(radixMask + 1));
+
+        std::vector<SortItem> items(count);
+        {
+            uint32_t corner = 0;
+            for( const auto& segment : corners )
+            {
+                for( const auto& index : segment )
+                {
+                    SortItem& item = items[corner];
+                    pack(item, uint32_t(index.normalIndex), normalOffset);
+                    pack(item, uint32_t(index.textureIndex), textureOffset);
+                    pack(item, uint32_t(index.vertexIndex), vertexOffset);
+                    item.corner = corner++;
+
+                    for( unsigned pass = 0; pass < passes; ++pass )
+                    {
+                        ++histograms[pass][digit(item, pass * radixBits, radixMask)];
+                    }
+                }
+            }
+        }
+
+        // least significant digit radix sort. Every pass is stable, equal
+        // keys stay ordered by corner number
+        std::vector<SortItem> sorted(count);
+
+        for( unsigned pass = 0; pass < passes; ++pass )
+        {
+            const unsigned shift = pass * radixBits;
+            auto& buckets = histograms[pass];
+
+            // nothing to do when all the keys have the same digit
+            if( buckets[digit(items[0], shift, radixMask)] == count )
+            {
+                continue;
+            }
+
+            uint32_t offset = 0;
+            for( auto& bucket : buckets )
+            {
+                const uint32_t size = bucket;
+                bucket = offset;
+                offset += size;
+            }
+
+            for( const auto& item : items )
+            {
+                sorted[buckets[digit(item, shift, radixMask)]++] = item;
+            }
+
+            items.swap(sorted);
+        }
+
+        sorted.clear();
+        sorted.shrink_to_fit();
+
+        // every corner points to the first corner with the same key
+        auto& vertexOfCorner = result.vertexOfCorner;
+        vertexOfCorner.resize(count);
+
+        for( size_t i = 0; i < count; ++i )
+        {
+            const bool runStart = (i == 0) || (items[i].low != items[i-1].low) ||
+                                  (items[i].high != items[i-1].high);
+            vertexOfCorner[items[i].corner] = runStart ? items[i].corner
+                                                       : vertexOfCorner[items[i-1].corner];
+        }
+
+        items.clear();
+        items.shrink_to_fit();
+
+        // number the vertices in the order their first corner appears. The
+        // first corner of a run has the smallest number, it is always
+        // numbered before the corners that point to it
+        uint32_t corner = 0;
+        for( const auto& segment : corners )
+        {
+            for( const auto& index : segment )
+            {
+                if( vertexOfCorner[corner] == corner )
+                {
+                    vertexOfCorner[corner] = (uint32_t)result.vertices.size();
+                    result.vertices.push_back(index);
+                }
+                else
+                {
+                    vertexOfCorner[corner] = vertexOfCorner[vertexOfCorner[corner]];
+                }
+
+                ++corner;
+            }
+        }
+    }
+}
@@ -0,0 +1,58 @@
+//
+//  VertexWelder.h
+//  WavefrontViewer
+//
+//  Created by Marius Sincovici on 18/10/2026.
+//  Copyright © 2026 Marius Sincovici. All rights reserved.
+//
+
+#ifndef VertexWelder_h
+#define VertexWelder_h
+
+#include <vector>
+#include <cinttypes>
+#include <cstddef>
+
+#include "types.h"
+
+namespace WavefrontFileReader
+{
+    /// Face corners split in several arrays, usually one for every mesh
+    typedef std::vector<ArrayView<IndexData>> CornerSegments;
+
+    /**
+     * Vertices shared by face corners. Corners are numbered in order over all
+     * the segments and vertices in the order their first corner appears, so
+     * all the welding functions give the same result.
+     */
+    struct WeldResult
+    {
+        std::vector<uint32_t> vertexOfCorner; /// vertex used by every corner
+        std::vector<IndexData> vertices; /// indices of every vertex
+    };
+
+    /**
+     * Find the corners with the same indices using a hash table lookup for
+     * every corner
+     *
+     * @param corners - corners to weld
+     * @param expectedCount - expected number of vertices, used to size the table
+     * @param result - receives the vertices
+     */
+    void weldWithHash(const CornerSegments& corners, size_t expectedCount,
+                      WeldResult& result);
+
+    /**
+     * Find the corners with the same indices by packing every corner in a
+     * 64 or 96 bits key and radix sorting the keys. Equal corners become
+     * neighbours and are numbered in a linear pass. Memory is only accessed
+     * sequentially, which scales better than hashing for tens of millions
+     * of corners.
+     *
+     * @param corners - corners to weld
+     * @param result - receives the vertices
+     */
+    void weldWithSort(const CornerSegments& corners, WeldResult& result);
+}
+
+#endif /* VertexWelder_h */
@@ -14,9 +14,16 @@
 #include <iostream>
 #include <numeric>
 #include <stdexcept>
-#include <future>
+#include <cstring>
+#include <algorithm>
 
 #include "WavefrontObject.hpp"
+#include "Bounds.h"
+#include "MappedFile.h"
+#include "NumberScanner.h"
+#include "LineScanner.h"
+#include "AsyncLoader.h"
+#include "ThreadPool.h"
 
 using namespace std;
 namespace WavefrontFileReader
@@ -24,175 +31,390 @@ namespace WavefrontFileReader
 #pragma mark - Private definition
     
     /**
-     * Tokenize string using the specified delimiters.
+     * Parse a buffer that contains complete lines from a Wavefront file and
+     * add the result to object
      *
-     * @param str - string that will be tokenized
-     * @param tokens - vector with tokens. Vector will be cleared before adding
-     *                  new tokens
-     * @param delimiters - delimiters used to tokenize the string
+     * @param begin - first character of the buffer
+     * @param end - one past the last character of the buffer
+     * @param object - object that will receive the parsed data
      */
-    void tokenize(const std::string& str,
-                  std::vector<std::string>& tokens,
-                  const std::string& delimiters = "\t #");
+    void parseBuffer(const char* begin, const char* end, Object& object);
+    
+    /**
+     * Process a tokenized line from a Wavefront file and add the result to
+     * object
+     *
+     * @param tokens - line tokens split by @see LineScanner. Must not be empty
+     * @param object - object that will receive the parsed data
+     */
+    void parseLine(const std::vector<Token>& tokens, Object& object);
+    
+    /// Files are split in chunks of at least this size when parsed in parallel
+    const size_t kMinChunkSize = 64 * 1024;
+    
+    /**
+     * Parse a part of a Wavefront file. The first mesh from the chunk has no
+     * name and receives the faces found before the first group ('g ...')
+     * line, which belong to the last mesh of the previous chunk.
+     *
+     * @param begin - first character of the chunk. Must be a line start
+     * @param end - one past the last character of the chunk
+     * @param chunk - object that will receive the parsed data
+     */
+    void parseChunk(const char* begin, const char* end, Object& chunk);
+    
+    /**
+     * Concatenate the objects created by @see parseChunk in the order in
+     * which they appear in file.
+     *
+     * @return Returns the same object that is created by parsing the whole
+     *          file with a single call to @see parseLine for each line
+     */
+    std::shared_ptr<IObject> mergeChunks(std::vector<Object>& chunks);
     
     /**
      * Process a face ('f ...') from Wavefront file.
      *
-     * @param tokens - list of tokens split using delimitates from @see tokenize
-     *              method. The first token is always 'f'.
+     * @param tokens - list of tokens split by @see LineScanner. The first
+     *              token is always 'f'.
+     * @param faces - list that will receive the face
      *
-     * @return A face object
+     * @return Number of indices in the face
      */
-    Face processFace(const std::vector<std::string>& tokens);
+    size_t processFace(const std::vector<Token>& tokens, FaceList& faces);
     
     /**
      * Fill a @see vec3 object with the information from tokens.
      * Used to read vertex position, texture coords and normals.
      *
-     * @param tokens - list of tokens split using delimitates from @see tokenize
-     *              method. The first token is a string representing the type
-     *              of the coordinates ('v', 'vt', 'vn' ...).
+     * @param tokens - list of tokens split by @see LineScanner. The first
+     *              token is a string representing the type of the
+     *              coordinates ('v', 'vt', 'vn' ...).
      *
      * @return Returns a vec3 object. If there are not sufficient tokens for
      *          all vec3 components they are set to zero
      */
-    fvec3 processVec3(const std::vector<std::string>& tokens);
+    fvec3 processVec3(const std::vector<Token>& tokens);
+    
+    /**
+     * Name of a group ('g ...'), the tokens after 'g' separated by a space
+     *
+     * @param tokens - list of tokens split by @see LineScanner. The first
+     *              token is always 'g'.
+     */
+    std::string processGroup(const std::vector<Token>& tokens);
+    
+    /// Initial size of the blocks read by @see parseStream. Lines that don't
+    /// fit make the block larger
+    const size_t kStreamBlockSize = 256 * 1024;
     
     
     void loadFile(const string& filePath, std::function<void(std::shared_ptr<IObject> object)> func)
     {
-        std::async([filePath, func]() {
-            ifstream file(filePath);
-            
-            if( !file.is_open() )
+        // the handle isn't needed, the load runs until it calls func
+        loadFileAsync(filePath, std::move(func));
+    }
+    
+    std::shared_ptr<IObject> loadFile(const string& filePath)
+    {
+        return loadMappedFile(filePath);
+    }
+    
+    std::shared_ptr<IObject> loadMappedFile(const std::string& filePath)
+    {
+        MappedFile file(filePath);
+        
+        return loadBuffer(file.data(), file.size());
+    }
+    
+    std::shared_ptr<IObject> loadBuffer(const char* data, size_t size)
+    {
+        std::shared_ptr<IObject> objPtr = std::shared_ptr<IObject>(new Object());
+        auto& object = *(Object*)(objPtr.get());
+        
+        parseBuffer(data, data + size, object);
+        computeObjectBounds(object);
+        
+        return objPtr;
+    }
+    
+    std::shared_ptr<IObject> loadBuffer(const char* data, size_t size,
+                                        const ProgressHandler& progress)
+    {
+        std::shared_ptr<IObject> objPtr = std::shared_ptr<IObject>(new Object());
+        auto& object = *(Object*)(objPtr.get());
+        
+        // the lines of a step are parsed as if the buffer was parsed at once
+        const char* begin = data;
+        const char* end = data + size;
+        while( begin != end )
+        {
+            const char* stepEnd = end;
+            if( size_t(end - begin) > kProgressStep )
             {
-                throw std::runtime_error("Could not open file");
+                const char* lineEnd = (const char*)memchr(begin + kProgressStep, '\n',
+                                                          end - begin - kProgressStep);
+                stepEnd = (lineEnd != nullptr) ? lineEnd + 1 : end;
             }
             
-            auto ptr = loadFile(file);
+            parseBuffer(begin, stepEnd, object);
+            begin = stepEnd;
             
-            func(ptr);
-        });
+            if( !progress(size_t(begin - data)) )
+            {
+                return nullptr;
+            }
+        }
+        computeObjectBounds(object);
+        
+        return objPtr;
     }
     
-    std::shared_ptr<IObject> loadFile(const string& filePath)
+    std::shared_ptr<IObject> loadFileParallel(const std::string& filePath,
+                                              unsigned threadCount)
+    {
+        MappedFile file(filePath);
+        
+        return loadBufferParallel(file.data(), file.size(), threadCount);
+    }
+    
+    std::shared_ptr<IObject> loadBufferParallel(const char* data, size_t size,
+                                                unsigned threadCount)
     {
-        ifstream file(filePath);
+        if( threadCount == 0 )
+        {
+            threadCount = ThreadPool::shared().threadCount();
+        }
+        
+        // don't split small files, the threads cost more then the parsing
+        const size_t chunksCount = std::min<size_t>(threadCount,
+                                                    size / kMinChunkSize + 1);
+        
+        if( chunksCount <= 1 )
+        {
+            return loadBuffer(data, size);
+        }
         
-        if( !file.is_open() )
+        // split the buffer in chunks that start at the beginning of a line
+        std::vector<const char*> bounds(chunksCount + 1, data + size);
+        bounds[0] = data;
+        for( size_t i = 1; i < chunksCount; ++i )
         {
-            throw std::runtime_error("Could not open file");
+            const char* ptr = std::max(bounds[i-1], data + (size / chunksCount) * i);
+            const char* end = data + size;
+            const char* lineEnd = (const char*)memchr(ptr, '\n', end - ptr);
+            bounds[i] = (lineEnd != nullptr) ? lineEnd + 1 : end;
         }
         
-        return loadFile(file);
+        std::vector<Object> chunks(chunksCount);
+        ThreadPool::shared().parallelFor(chunksCount, [&bounds, &chunks](size_t i) {
+            parseChunk(bounds[i], bounds[i+1], chunks[i]);
+        }, threadCount);
+        
+        return mergeChunks(chunks);
     }
     
     std::shared_ptr<IObject> loadFile(std::istream& stream)
     {
-        string line;
-        std::vector<std::string> tokens;
-        
         std::shared_ptr<IObject> objPtr = std::shared_ptr<IObject>(new Object());
         auto& object = *(Object*)(objPtr.get());
         
-        while( stream.good() )
+        StreamHandlers handlers;
+        handlers.vertices = [&object](ArrayView<fvec3> vertices) {
+            object.vertices.insert(object.vertices.end(), vertices.begin(), vertices.end());
+        };
+        handlers.texCoords = [&object](ArrayView<fvec3> texCoords) {
+            object.texCoords.insert(object.texCoords.end(), texCoords.begin(), texCoords.end());
+        };
+        handlers.normals = [&object](ArrayView<fvec3> normals) {
+            object.normals.insert(object.normals.end(), normals.begin(), normals.end());
+        };
+        handlers.group = [&object](const std::string& name) {
+            Mesh g;
+            g.name = name;
+            object.meshes.push_back(std::move(g));
+        };
+        handlers.faces = [&object](const FaceList& faces) {
+            if( object.meshes.empty() )
+            {
+                object.meshes.push_back(Mesh());
+            }
+            
+            auto& mesh = object.meshes.back();
+            mesh.faces.append(faces);
+            mesh.numberOfElementsInFace = int(faces.back().indices.size());
+        };
+        
+        parseStream(stream, handlers);
+        computeObjectBounds(object);
+        
+        return objPtr;
+    }
+    
+    /**
+     * Collects the elements of a stream in batches and hands them to the
+     * handlers
+     */
+    class StreamParser
+    {
+    public:
+        StreamParser(const StreamHandlers& handlers, size_t batchSize)
+        : m_handlers(handlers), m_batchSize(std::max<size_t>(batchSize, 1)) {}
+        
+        /// Process a tokenized line, @see parseLine
+        void parseLine(const std::vector<Token>& tokens)
         {
-            stream >> std::ws;
+            const Token& type = tokens[0];
             
-            if( ! std::getline(stream, line) )
+            if( type == "v" )
             {
-                break;
+                add(m_handlers.vertices, m_vertices, tokens);
             }
-            
-            if( !line.empty() )
+            else if( type == "vt" )
             {
-                if( line.back() == '\r' )
-                {
-                    line.pop_back();
-                }
+                add(m_handlers.texCoords, m_texCoords, tokens);
             }
-            
-            if( line.empty() )
+            else if( type == "vn" )
             {
-                continue;
+                add(m_handlers.normals, m_normals, tokens);
             }
-            
-            assert(line.front() != ' ');
-            
-            if( line.front() == '#' )
+            else if( type == "g" )
             {
-                // ignore white spaces
-                continue;
+                flushFaces();
+                if( m_handlers.group )
+                {
+                    m_handlers.group(processGroup(tokens));
+                }
             }
-            
-            tokenize(line, tokens);
-            if( tokens.empty() )
+            else if( (type == "f") && m_handlers.faces )
             {
-                continue;
+                processFace(tokens, m_faces);
+                if( m_faces.size() >= m_batchSize )
+                {
+                    flushFaces();
+                }
+            }
+        }
+        
+        /// Hand all the collected elements
+        void flush()
+        {
+            flushFaces();
+        }
+        
+    private:
+        /// Collect a position, texture coordinate or normal
+        void add(const std::function<void(ArrayView<fvec3>)>& handler,
+                 std::vector<fvec3>& batch, const std::vector<Token>& tokens)
+        {
+            if( !handler )
+            {
+                return;
             }
             
-            const std::string& type = tokens[0];
-            
-            if( type == "v" )
+            batch.push_back(processVec3(tokens));
+            if( batch.size() >= m_batchSize )
             {
-                // vertex
-                auto vertex = processVec3(tokens);
-                object.vertices.push_back(vertex);
+                flush(handler, batch);
             }
-            else if( type == "vt")
+        }
+        
+        void flush(const std::function<void(ArrayView<fvec3>)>& handler,
+                   std::vector<fvec3>& batch)
+        {
+            if( !batch.empty() )
             {
-                // texture coordinates
-                auto coord = processVec3(tokens);
-                object.texCoords.push_back(coord);
+                handler(ArrayView<fvec3>(batch.data(), batch.data() + batch.size()));
+                batch.clear();
             }
-            else if( type == "vn")
+        }
+        
+        /// Hand the faces, after the elements they may use
+        void flushFaces()
+        {
+            flush(m_handlers.vertices, m_vertices);
+            flush(m_handlers.texCoords, m_texCoords);
+            flush(m_handlers.normals, m_normals);
+            
+            if( !m_faces.empty() )
             {
-                // normal
-                auto normal = processVec3(tokens);
-                object.normals.push_back(normal);
+                m_handlers.faces(m_faces);
+                m_faces.clear();
             }
-            else if( type == "g" )
+        }
+        
+        const StreamHandlers& m_handlers; /// receive the batches
+        const size_t m_batchSize; /// maximum number of elements of a batch
+        
+        std::vector<fvec3> m_vertices; /// positions not handled yet
+        std::vector<fvec3> m_texCoords; /// texture coordinates not handled yet
+        std::vector<fvec3> m_normals; /// normals not handled yet
+        FaceList m_faces; /// faces not handled yet
+    };
+    
+    size_t parseStream(std::istream& stream, const StreamHandlers& handlers, size_t batchSize)
+    {
+        StreamParser parser(handlers, batchSize);
+        std::vector<Token> tokens;
+        
+        // the block starts with the incomplete line left by the previous one
+        std::vector<char> block(kStreamBlockSize);
+        size_t pending = 0, bytesRead = 0;
+        bool finished = false;
+        
+        while( !finished )
+        {
+            stream.read(block.data() + pending, std::streamsize(block.size() - pending));
+            const size_t count = size_t(stream.gcount());
+            bytesRead += count;
+            finished = !stream;
+            
+            const char* begin = block.data();
+            const char* end = begin + pending + count;
+            
+            // only complete lines are scanned, the last line of the stream
+            // is complete at its end
+            const char* linesEnd = end;
+            if( !finished )
             {
-                // group name
-                Mesh g;
-                g.name.reserve(line.size());
-                for( auto it = tokens.begin()+1; it != tokens.end(); ++it )
+                while( (linesEnd != begin) && (linesEnd[-1] != '\n') )
                 {
-                    if( !g.name.empty() )
-                    {
-                        g.name += " ";
-                    }
-                    g.name += *it;
+                    --linesEnd;
                 }
                 
-                object.meshes.push_back(std::move(g));
+                if( linesEnd == begin )
+                {
+                    // the line doesn't fit in the block
+                    pending = block.size();
+                    block.resize(block.size() * 2);
+                    continue;
+                }
             }
-            else if( type == "f" )
+            
+            LineScanner scanner(begin, linesEnd);
+            while( scanner.nextLine(tokens) )
             {
-                // face
-                if( object.meshes.empty() )
+                if( !tokens.empty() )
                 {
-                    object.meshes.push_back(Mesh());
+                    parser.parseLine(tokens);
                 }
-                
-                auto& mesh = object.meshes.back();
-                
-                auto face = processFace(tokens);
-                mesh.numberOfElementsInFace = int(face.indices.size());
-                mesh.faces.push_back(std::move(face));
             }
+            
+            pending = size_t(end - linesEnd);
+            memmove(block.data(), linesEnd, pending);
         }
         
-        return objPtr;
+        parser.flush();
+        return bytesRead;
     }
     
     bool validateObject(const IObject& object)
     {
         for( const auto& mesh : object.meshes )
         {
-            for( auto& face : mesh.faces )
+            for( const auto& face : mesh.faces )
             {
-                for( auto& index : face.indices )
+                for( const auto& index : face.indices )
                 {
                     if( abs(index.vertexIndex) > object.vertices.size() )
                     {
@@ -215,85 +437,178 @@ namespace WavefrontFileReader
     }
     
 #pragma mark - Private methods
-    void tokenize(const std::string& str,
-                  vector<string>& tokens,
-                  const std::string& delimiters)
+    void parseBuffer(const char* begin, const char* end, Object& object)
     {
-        tokens.clear();
+        std::vector<Token> tokens;
         
-        if( str.empty() )
+        LineScanner scanner(begin, end);
+        while( scanner.nextLine(tokens) )
         {
-            return;
+            if( !tokens.empty() )
+            {
+                parseLine(tokens, object);
+            }
         }
+    }
+    
+    void parseLine(const vector<Token>& tokens, Object& object)
+    {
+        const Token& type = tokens[0];
         
-        size_t startPos = 0;
-        size_t endPos = str.find_first_of(delimiters);
-        while (endPos != std::string::npos )
+        if( type == "v" )
         {
-            if( startPos < endPos )
+            // vertex
+            auto vertex = processVec3(tokens);
+            object.vertices.push_back(vertex);
+        }
+        else if( type == "vt")
+        {
+            // texture coordinates
+            auto coord = processVec3(tokens);
+            object.texCoords.push_back(coord);
+        }
+        else if( type == "vn")
+        {
+            // normal
+            auto normal = processVec3(tokens);
+            object.normals.push_back(normal);
+        }
+        else if( type == "g" )
+        {
+            // group name
+            Mesh g;
+            g.name = processGroup(tokens);
+            
+            object.meshes.push_back(std::move(g));
+        }
+        else if( type == "f" )
+        {
+            // face
+            if( object.meshes.empty() )
+            {
+                object.meshes.push_back(Mesh());
+            }
+            
+            auto& mesh = object.meshes.back();
+            
+            mesh.numberOfElementsInFace = int(processFace(tokens, mesh.faces));
+        }
+    }
+    
+    void parseChunk(const char* begin, const char* end, Object& chunk)
+    {
+        // receives faces that continue the mesh from previous chunk
+        chunk.meshes.push_back(Mesh());
+        
+        parseBuffer(begin, end, chunk);
+    }
+    
+    /**
+     * Append all the elements from source at the end of destination
+     */
+    template<class T>
+    void append(std::vector<T>& destination, std::vector<T>& source)
+    {
+        destination.insert(destination.end(),
+                           std::make_move_iterator(source.begin()),
+                           std::make_move_iterator(source.end()));
+        source = std::vector<T>();
+    }
+    
+    std::shared_ptr<IObject> mergeChunks(std::vector<Object>& chunks)
+    {
+        std::shared_ptr<IObject> objPtr = std::shared_ptr<IObject>(new Object());
+        auto& object = *(Object*)(objPtr.get());
+        
+        size_t verticesCount = 0, texCoordsCount = 0, normalsCount = 0;
+        size_t meshesCount = 0;
+        for( const auto& chunk : chunks )
+        {
+            verticesCount += chunk.vertices.size();
+            texCoordsCount += chunk.texCoords.size();
+            normalsCount += chunk.normals.size();
+            meshesCount += chunk.meshes.size();
+        }
+        
+        object.vertices.reserve(verticesCount);
+        object.texCoords.reserve(texCoordsCount);
+        object.normals.reserve(normalsCount);
+        object.meshes.reserve(meshesCount);
+        
+        for( auto& chunk : chunks )
+        {
+            // indices from faces are absolute, they don't need to be changed
+            append(object.vertices, chunk.vertices);
+            append(object.texCoords, chunk.texCoords);
+            append(object.normals, chunk.normals);
+            
+            auto& continuation = chunk.meshes.front();
+            if( !continuation.faces.empty() )
             {
-                auto token = str.substr(startPos, endPos-startPos);
-                if( token.front() == '#' )
+                if( object.meshes.empty() )
                 {
-                    // comment detected, ignore everything till the end of line
-                    return;
+                    object.meshes.push_back(Mesh());
                 }
-                tokens.push_back(std::move(token));
+                
+                auto& mesh = object.meshes.back();
+                mesh.faces.append(continuation.faces);
+                mesh.numberOfElementsInFace = continuation.numberOfElementsInFace;
             }
             
-            startPos = endPos + 1;
-            endPos = str.find_first_of(delimiters, startPos);
+            object.meshes.insert(object.meshes.end(),
+                                 std::make_move_iterator(chunk.meshes.begin() + 1),
+                                 std::make_move_iterator(chunk.meshes.end()));
+            chunk.meshes.clear();
         }
+        computeObjectBounds(object);
         
-        auto token = str.substr(startPos);
-        tokens.push_back(std::move(token));
+        return objPtr;
     }
     
-    Face processFace(const vector<string>& tokens)
+    size_t processFace(const vector<Token>& tokens, FaceList& faces)
     {
-        Face face;
-        
         for( auto it = tokens.begin()+1; it != tokens.end(); ++it )
         {
             IndexData indexData;
             
-            const char* ptr = (*it).c_str();
-            char* pEnd = nullptr;
-            
-            indexData.vertexIndex = std::strtod(ptr, &pEnd);
+            scanIndexData(it->begin, it->end, indexData);
             
             if( indexData.vertexIndex <= 0 )
             {
                 continue;
             }
             
-            if( *pEnd == '/' )
+            faces.addIndex(indexData);
+        }
+        
+        return faces.finishFace();
+    }
+    
+    std::string processGroup(const vector<Token>& tokens)
+    {
+        std::string name;
+        name.reserve(tokens.back().end - tokens[0].end);
+        for( auto it = tokens.begin()+1; it != tokens.end(); ++it )
+        {
+            if( !name.empty() )
             {
-                indexData.textureIndex = std::strtod(pEnd+1, &pEnd);
-                
-                if( *pEnd == '/' )
-                {
-                    indexData.normalIndex = std::strtod(pEnd+1, &pEnd);
-                    assert(indexData.normalIndex > 0);
-                }
+                name += " ";
             }
-            
-            face.indices.push_back(indexData);
+            name.append(it->begin, it->size());
         }
-        
-        return face;
+        return name;
     }
     
-    fvec3 processVec3(const vector<string>& tokens)
+    fvec3 processVec3(const vector<Token>& tokens)
     {
         fvec3 v;
         
         size_t tokensSize = tokens.size();
         
         size_t i = 1;
-        v.x = (i < tokensSize) ? std::stof(tokens[i++].c_str()) : 0.0f;
-        v.y = (i < tokensSize) ? std::stof(tokens[i++].c_str()) : 0.0f;
-        v.z = (i < tokensSize) ? std::stof(tokens[i++].c_str()) : 0.0f;
+        if( i < tokensSize ) { scanFloat(tokens[i].begin, tokens[i].end, v.x); ++i; }
+        if( i < tokensSize ) { scanFloat(tokens[i].begin, tokens[i].end, v.y); ++i; }
+        if( i < tokensSize ) { scanFloat(tokens[i].begin, tokens[i].end, v.z); ++i; }
         
         return v;
     }
@@ -36,8 +36,106 @@ namespace WavefrontFileReader
      * @param filePath - full path to the Wavefront file
      */
     std::shared_ptr<IObject> loadFile(const std::string& filePath);
+
+    /**
+     * Load and parse the specified Wavefront file on a worker thread.
+     * Returns at once, @see loadFileAsync
+     * @param filePath - full path to the Wavefront file
+     * @param func - called on the worker thread with the object, or nullptr
+     *              when the load failed
+     */
     void loadFile(const std::string& filePath, std::function<void(std::shared_ptr<IObject> object)>);
 
+    /**
+     * Load and parse the specified Wavefront file by mapping it in memory.
+     * Lines and tokens are read directly from the mapped bytes, without
+     * copying them.
+     * @param filePath - full path to the Wavefront file
+     */
+    std::shared_ptr<IObject> loadMappedFile(const std::string& filePath);
+
+    /**
+     * Parse a Wavefront file content that is already in memory
+     * @param data - first byte of the content. Doesn't need to be null
+     *              terminated
+     * @param size - content size in bytes
+     */
+    std::shared_ptr<IObject> loadBuffer(const char* data, size_t size);
+
+    /**
+     * Receives the number of bytes parsed so far. Returning false stops the
+     * parsing
+     */
+    typedef std::function<bool(size_t bytesParsed)> ProgressHandler;
+
+    /// Bytes parsed between two calls of a @see ProgressHandler
+    const size_t kProgressStep = 1024 * 1024;
+
+    /**
+     * @see loadBuffer that reports its progress after every kProgressStep
+     * bytes, at line boundaries, and after the last byte
+     * @return the parsed object, nullptr when progress stopped the parsing
+     */
+    std::shared_ptr<IObject> loadBuffer(const char* data, size_t size,
+                                        const ProgressHandler& progress);
+
+    /**
+     * Load and parse the specified Wavefront file using multiple threads.
+     * The file is split in chunks at line boundaries, every chunk is parsed
+     * on a thread of the pool and the results are merged in file order, so the
+     * object is identical with the one returned by @see loadFile.
+     * @param filePath - full path to the Wavefront file
+     * @param threadCount - maximum number of threads. When 0 all the threads
+     *              of the shared @see ThreadPool are used
+     */
+    std::shared_ptr<IObject> loadFileParallel(const std::string& filePath,
+                                              unsigned threadCount = 0);
+
+    /**
+     * Parallel version of @see loadBuffer
+     */
+    std::shared_ptr<IObject> loadBufferParallel(const char* data, size_t size,
+                                                unsigned threadCount = 0);
+
+    /**
+     * Handlers of the elements found by @see parseStream. Every handler is
+     * optional, the elements without a handler are not parsed. The batches
+     * are only valid during the call.
+     */
+    struct StreamHandlers
+    {
+        /// Positions ('v ...') in file order
+        std::function<void(ArrayView<fvec3> vertices)> vertices;
+
+        /// Texture coordinates ('vt ...') in file order
+        std::function<void(ArrayView<fvec3> texCoords)> texCoords;
+
+        /// Normals ('vn ...') in file order
+        std::function<void(ArrayView<fvec3> normals)> normals;
+
+        /// Faces ('f ...') of the current group. Every position, texture
+        /// coordinate and normal before them was already handled
+        std::function<void(const FaceList& faces)> faces;
+
+        /// Start of a group ('g ...'), the faces before it were already handled
+        std::function<void(const std::string& name)> group;
+    };
+
+    /// Elements handled at once by @see parseStream
+    const size_t kStreamBatchSize = 4096;
+
+    /**
+     * Scan a Wavefront file and hand its elements to handlers in batches,
+     * without keeping them. The stream is read in blocks, so huge files are
+     * processed in constant memory.
+     * @param stream - file stream
+     * @param handlers - receive the elements
+     * @param batchSize - maximum number of elements of a batch
+     * @return Returns the number of bytes read
+     */
+    size_t parseStream(std::istream& stream, const StreamHandlers& handlers,
+                       size_t batchSize = kStreamBatchSize);
+
     /**
      * Validates vertex, normal, texture indices
      * @return Return true if the indices values are in range, false otherwise
@@ -8,117 +8,385 @@
 
 #include "WavefrontObject.hpp"
 
-#include <unordered_map>
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <iostream>
 
 #include "types.h"
+#include "Bounds.h"
+#include "Meshlets.h"
+#include "MeshOptimizer.h"
+#include "ShortIndices.h"
+#include "Simplifier.h"
+#include "VertexPacking.h"
+#include "VertexWelder.h"
+#include "ThreadPool.h"
 
 namespace WavefrontFileReader
 {
-    typedef IndexData KeyType;
-
     /**
-     * Used for hashing a IndexData. Needed for unordered_map
+     * Estimate the number of unique vertices, used to size the dedup table.
+     * Every position, texture coordinate and normal is usually referenced by
+     * at least one corner, and corners rarely combine them in many ways.
      */
-    struct KeyTypeHash
+    static size_t expectedVerticesCount(const IObject& object,
+                                        const Mesh* first, const Mesh* last)
     {
-        std::size_t operator()(const KeyType& k) const
+        size_t cornersCount = 0;
+        for( const Mesh* mesh = first; mesh != last; ++mesh )
         {
-            return k.vertexIndex ^ k.normalIndex ^ k.textureIndex;
+            cornersCount += mesh->faces.indices().size();
         }
-    };
+        
+        const size_t attributesCount = std::max(object.vertices.size(),
+                                                std::max(object.texCoords.size(),
+                                                         object.normals.size()));
+        return std::min(cornersCount, attributesCount);
+    }
     
+    uint64_t optionsKey(const VertexBufferOptions& options)
+    {
+        // FNV-1a of the options that change the buffer. The welding method
+        // and the threads don't
+        uint64_t key = 14695981039346656037ull;
+        auto add = [&key](const void* data, size_t size) {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            for( size_t i = 0; i < size; ++i )
+            {
+                key = (key ^ bytes[i]) * 1099511628211ull;
+            }
+        };
+
+        const uint8_t flags[] = {
+            options.splitInTriangles, options.optimizeVertexCache, options.optimizeOverdraw,
+            options.optimizeVertexFetch, options.shortIndices, options.splitCommands,
+            options.meshlets
+        };
+        add(flags, sizeof(flags));
+
+        const uint32_t format = options.vertexFormat;
+        add(&format, sizeof(format));
+
+        const uint32_t lodsCount = uint32_t(options.lodRatios.size());
+        add(&lodsCount, sizeof(lodsCount));
+        add(options.lodRatios.data(), options.lodRatios.size() * sizeof(float));
+
+        return key;
+    }
+
     void Object::generateVertexBuffers(const bool splitInTriangles) const
     {
-        m_vertexBuffer.clear();
+        VertexBufferOptions options;
+        options.splitInTriangles = splitInTriangles;
+        generateVertexBuffers(options);
+    }
+    
+    /**
+     * Build the vertex buffer for a range of meshes. The meshes share the
+     * vertices with the same indices
+     *
+     * @param object - object that owns the meshes
+     * @param first - first mesh
+     * @param last - one past the last mesh
+     * @param options - how the buffer is built
+     * @param buffer - receives the vertices, indices and commands
+     */
+    static void buildVertexBuffer(const IObject& object, const Mesh* first, const Mesh* last,
+                                  const VertexBufferOptions& options, VertexBuffer& buffer)
+    {
+        const auto& vertices = object.vertices;
+        const auto& texCoords = object.texCoords;
+        const auto& normals = object.normals;
         
-        std::unordered_map<KeyType, uint32_t, KeyTypeHash> duplicateVertices;
+        buffer.clear();
+        
+        CornerSegments corners;
+        corners.reserve(last - first);
+        for( const Mesh* mesh = first; mesh != last; ++mesh )
+        {
+            const auto& indices = mesh->faces.indices();
+            corners.push_back(ArrayView<IndexData>(indices.data(),
+                                                   indices.data() + indices.size()));
+        }
+        
+        WeldResult weld;
+        switch( options.welding )
+        {
+            case VertexBufferOptions::Sort:
+                weldWithSort(corners, weld);
+                break;
+                
+            case VertexBufferOptions::Hash:
+            default:
+                weldWithHash(corners, expectedVerticesCount(object, first, last), weld);
+                break;
+        }
         
         double maxCoordinateValue = 0;
         
-        for( const auto& mesh : meshes )
+        buffer.vbo.reserve(weld.vertices.size());
+        for( const auto& index : weld.vertices )
         {
-            auto& ibo = m_vertexBuffer.ibo;
+            Vertex vertex;
+            
+            assert( (index.vertexIndex > 0) &&
+                   (index.vertexIndex <= vertices.size()) );
             
-            Command command;
-            command.index = (uint32_t)m_vertexBuffer.ibo.size();
-            command.type = (splitInTriangles || (mesh.numberOfElementsInFace == 3) )
-            ? Command::Triangles : Command::Quads;
+            vertex.position = vertices[index.vertexIndex-1];
             
-            for( const auto& face: mesh.faces )
+            maxCoordinateValue = std::max(maxCoordinateValue,
+                                            fabs(vertex.position.x));
+            maxCoordinateValue = std::max(maxCoordinateValue,
+                                            fabs(vertex.position.y));
+            maxCoordinateValue = std::max(maxCoordinateValue,
+                                            fabs(vertex.position.z));
+            
+            if( index.normalIndex > 0 )
             {
-                short i = 0;
-                for( auto& index : face.indices )
+                assert( (index.normalIndex > 0) &&
+                       (index.normalIndex <= normals.size()) );
+                
+                vertex.normal = normals[index.normalIndex-1];
+            }
+            
+            if( index.textureIndex > 0 )
+            {
+                assert( (index.textureIndex > 0) &&
+                       (index.textureIndex <= texCoords.size()) );
+                
+                vertex.texture = texCoords[index.textureIndex-1];
+            }
+            
+            buffer.vbo.push_back(vertex);
+        }
+        
+        const bool splitInTriangles = options.splitInTriangles;
+        auto& ibo = buffer.ibo;
+        const uint32_t* vertexOfCorner = weld.vertexOfCorner.data();
+        
+        for( const Mesh* mesh = first; mesh != last; ++mesh )
+        {
+            const uint32_t* meshCorners = vertexOfCorner;
+            
+            bool hasQuads = false, hasOthers = false;
+            if( !splitInTriangles )
+            {
+                for( const auto& face: mesh->faces )
                 {
-                    if( splitInTriangles && (++i >= 4) )
+                    hasQuads |= (face.indices.size() == 4);
+                    hasOthers |= (face.indices.size() != 4);
+                }
+            }
+            
+            // add a command with the faces of the type, every pass reads all
+            // the faces of the mesh
+            auto emitFaces = [&](Command::Type type) {
+                Command command;
+                command.index = (uint32_t)ibo.size();
+                command.type = type;
+                
+                const uint32_t* corners = meshCorners;
+                for( const auto& face: mesh->faces )
+                {
+                    const size_t size = face.indices.size();
+                    if( (type == Command::Quads) != (hasQuads && (size == 4)) )
                     {
-                        // make triangles from quads 1 2 3 4 --> (1 2 3) (1 3 4)
-                        auto a = *(ibo.end() - 3);
-                        auto b = *(ibo.end() - 1);
-                        
-                        ibo.push_back(a);
-                        ibo.push_back(b);
+                        corners += size;
+                        continue;
                     }
                     
-                    const auto it = duplicateVertices.find(index);
-                    
-                    if( it == duplicateVertices.end() )
+                    for( size_t i = 0; i < size; ++i )
                     {
-                        // not found. Add it to vbo, ibo and save the index to map
-                        Vertex vertex;
-                        
-                        assert( (index.vertexIndex > 0) &&
-                               (index.vertexIndex <= vertices.size()) );
-                        
-                        vertex.position = vertices[index.vertexIndex-1];
-                        
-                        maxCoordinateValue = std::max(maxCoordinateValue,
-                                                        fabs(vertex.position.x));
-                        maxCoordinateValue = std::max(maxCoordinateValue,
-                                                        fabs(vertex.position.y));
-                        maxCoordinateValue = std::max(maxCoordinateValue,
-                                                        fabs(vertex.position.z));
-                        
-                        if( index.normalIndex > 0 )
-                        {
-                            assert( (index.normalIndex > 0) &&
-                                   (index.normalIndex <= normals.size()) );
-                            
-                            vertex.normal = normals[index.normalIndex-1];
-                        }
-                        
-                        if( index.textureIndex > 0 )
+                        if( (type == Command::Triangles) && (i >= 3) )
                         {
-                            assert( (index.textureIndex > 0) &&
-                                   (index.textureIndex <= texCoords.size()) );
+                            // make triangles from quads 1 2 3 4 --> (1 2 3) (1 3 4)
+                            auto a = *(ibo.end() - 3);
+                            auto b = *(ibo.end() - 1);
                             
-                            vertex.texture = texCoords[index.textureIndex-1];
+                            ibo.push_back(a);
+                            ibo.push_back(b);
                         }
                         
-                        uint32_t position = (uint32_t)m_vertexBuffer.vbo.size();
-                        m_vertexBuffer.vbo.push_back(vertex);
-                        
-                        duplicateVertices[index] = position;
-                        
-                        ibo.push_back( position );
-                    }
-                    else
-                    {
-                        // already exist, only add it to index buffer
-                        assert( it->first == index );
-                        
-                        auto position = it->second;
-                        ibo.push_back( position );
+                        ibo.push_back( corners[i] );
                     }
+                    
+                    corners += size;
                 }
+                vertexOfCorner = corners;
+                
+                command.count = (int)ibo.size() - command.index;
+                command.bounds = commandBounds(buffer, command);
+                
+                buffer.commands.push_back(command);
+            };
+            
+            // quads are kept when the mesh isn't split in triangles, the
+            // other faces are always split so all the primitives of a
+            // command have the same size
+            if( hasQuads )
+            {
+                emitFaces(Command::Quads);
             }
             
-            command.count = (int)ibo.size() - command.index;
+            if( hasOthers || !hasQuads )
+            {
+                emitFaces(Command::Triangles);
+            }
+        }
+        
+        if( first != last )
+        {
+            buffer.scale = maxCoordinateValue;
+        }
+    }
+    
+    /**
+     * Append a vertex buffer built for other meshes. Indices and commands are
+     * moved after the existing ones
+     */
+    static void appendVertexBuffer(const VertexBuffer& segment, VertexBuffer& buffer)
+    {
+        const uint32_t vertexBase = (uint32_t)buffer.vbo.size();
+        const uint32_t indexBase = (uint32_t)buffer.ibo.size();
+        
+        buffer.vbo.insert(buffer.vbo.end(), segment.vbo.begin(), segment.vbo.end());
+        
+        for( const auto index : segment.ibo )
+        {
+            buffer.ibo.push_back(index + vertexBase);
+        }
+        
+        for( auto command : segment.commands )
+        {
+            command.index += indexBase;
+            buffer.commands.push_back(command);
+        }
+    }
+    
+    const VertexBuffer& Object::vertexBuffer() const
+    {
+        std::lock_guard<std::mutex> lock(m_buffersMutex);
+        if( m_vertexBuffer.empty() )
+        {
+            const VertexBufferOptions options;
+            buildBuffer(options, m_vertexBuffer);
+            m_vertexBufferKey = optionsKey(options);
+        }
+        return m_vertexBuffer;
+    }
+    
+    const VertexBuffer& Object::vertexBuffer(const VertexBufferOptions& options) const
+    {
+        const uint64_t key = optionsKey(options);
+        
+        BufferSlot* slot = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_buffersMutex);
+            if( !m_vertexBuffer.empty() && (m_vertexBufferKey == key) )
+            {
+                return m_vertexBuffer;
+            }
             
-            m_vertexBuffer.commands.push_back(command);
-            m_vertexBuffer.scale = maxCoordinateValue;
+            auto& entry = m_buffers[key];
+            if( !entry )
+            {
+                entry.reset(new BufferSlot());
+            }
+            slot = entry.get();
+        }
+        
+        // the other threads asking for the same options wait for this build
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        if( !slot->built )
+        {
+            buildBuffer(options, slot->buffer);
+            slot->built = true;
+        }
+        return slot->buffer;
+    }
+    
+    void Object::generateVertexBuffers(const VertexBufferOptions& options) const
+    {
+        std::lock_guard<std::mutex> lock(m_buffersMutex);
+        buildBuffer(options, m_vertexBuffer);
+        m_vertexBufferKey = optionsKey(options);
+    }
+    
+    void Object::buildBuffer(const VertexBufferOptions& options, VertexBuffer& buffer) const
+    {
+        if( !options.parallel || (meshes.size() <= 1) )
+        {
+            buildVertexBuffer(*this, meshes.data(), meshes.data() + meshes.size(),
+                              options, buffer);
+        }
+        else
+        {
+            buildVertexBufferParallel(options, buffer);
+        }
+        
+        if( !options.lodRatios.empty() )
+        {
+            generateLods(buffer, options.lodRatios);
+        }
+        
+        if( options.optimizeVertexCache )
+        {
+            optimizeVertexCache(buffer);
+        }
+        
+        if( options.optimizeOverdraw )
+        {
+            optimizeOverdraw(buffer);
+        }
+        
+        if( options.optimizeVertexFetch )
+        {
+            optimizeVertexFetch(buffer);
+        }
+        
+        if( options.shortIndices )
+        {
+            convertToShortIndices(buffer, options.splitCommands);
+        }
+        
+        packVertices(buffer, options.vertexFormat);
+        
+        if( options.meshlets )
+        {
+            buildMeshlets(buffer);
+        }
+    }
+    
+    void Object::buildVertexBufferParallel(const VertexBufferOptions& options,
+                                           VertexBuffer& buffer) const
+    {
+        
+        // meshes have very different sizes, every thread takes the next mesh
+        // that was not built yet
+        std::vector<VertexBuffer> segments(meshes.size());
+        ThreadPool::shared().parallelFor(meshes.size(), [this, &options, &segments](size_t i) {
+            buildVertexBuffer(*this, &meshes[i], &meshes[i] + 1, options, segments[i]);
+        }, options.threadCount);
+        
+        // segments are merged in mesh order, the result doesn't depend on
+        // the number of threads
+        size_t verticesCount = 0, indicesCount = 0;
+        for( const auto& segment : segments )
+        {
+            verticesCount += segment.vbo.size();
+            indicesCount += segment.ibo.size();
+        }
+        
+        buffer.clear();
+        buffer.vbo.reserve(verticesCount);
+        buffer.ibo.reserve(indicesCount);
+        buffer.scale = 0;
+        
+        for( const auto& segment : segments )
+        {
+            appendVertexBuffer(segment, buffer);
+            buffer.scale = std::max(buffer.scale, segment.scale);
         }
     }
 }
@@ -11,6 +11,9 @@
 
 #include <vector>
 #include <string>
+#include <map>
+#include <memory>
+#include <mutex>
 
 #include "types.h"
 #include "IObject.h"
@@ -22,20 +25,32 @@ namespace WavefrontFileReader
      */
     
     
+    /**
+     * Key of the options that change a vertex buffer. Buffers built with the
+     * same key are identical
+     */
+    uint64_t optionsKey(const VertexBufferOptions& options);
+    
     /**
      * Represents the Wavefront file content
      */
     class Object final : public IObject
     {
     public:
-        const VertexBuffer& vertexBuffer() const override
-        {
-            if( m_vertexBuffer.empty() )
-            {
-                generateVertexBuffers(true);
-            }
-            return m_vertexBuffer;
-        }
+        /**
+         * The buffer from the last @see generateVertexBuffers call. Built
+         * with the default options when there was none. Safe to call from
+         * several threads, the buffer is built once
+         */
+        const VertexBuffer& vertexBuffer() const override;
+        
+        /**
+         * Vertex buffer built with options. Concurrent calls with the same
+         * @see optionsKey wait for a single build, other options are built
+         * in parallel. The buffers stay valid as long as the object, the
+         * one from @see generateVertexBuffers is used when its options match
+         */
+        const VertexBuffer& vertexBuffer(const VertexBufferOptions& options) const override;
         
         /**
          * Checks if all the elements from object are empty or not
@@ -50,10 +65,46 @@ namespace WavefrontFileReader
          */
         void generateVertexBuffers(const bool splitInTriangles) const;
         
+        /**
+         * Create the vertex buffer. Replaces m_vertexBuffer, so it must not
+         * run while other threads use it
+         * @param options - how the buffer is built
+         */
+        void generateVertexBuffers(const VertexBufferOptions& options) const;
+        
+    private:
+        /**
+         * Build a vertex buffer
+         * @param options - how the buffer is built
+         * @param buffer - receives the buffer
+         */
+        void buildBuffer(const VertexBufferOptions& options, VertexBuffer& buffer) const;
+        
+        /**
+         * Build every mesh on a worker thread and merge the results in
+         * buffer. @see VertexBufferOptions::parallel
+         */
+        void buildVertexBufferParallel(const VertexBufferOptions& options,
+                                       VertexBuffer& buffer) const;
+        
+        /**
+         * Buffer of @see vertexBuffer(options), built once
+         */
+        struct BufferSlot
+        {
+            std::mutex mutex; /// held during the build
+            bool built = false;
+            VertexBuffer buffer;
+        };
+        
+        mutable std::mutex m_buffersMutex; /// guards m_vertexBuffer and m_buffers
+        mutable std::map<uint64_t, std::unique_ptr<BufferSlot>> m_buffers; /// by options key
+        
     public:
         
         
         mutable VertexBuffer m_vertexBuffer;
+        mutable uint64_t m_vertexBufferKey = 0; /// @see optionsKey of m_vertexBuffer
     };
 }
 
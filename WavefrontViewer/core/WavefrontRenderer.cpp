@@ -9,6 +9,11 @@
 #include "WavefrontRenderer.h"
 
 #include "WavefrontFileReader.h"
+#include "Meshlets.h"
+#include "ShortIndices.h"
+#include "Simplifier.h"
+#include "Triangulation.h"
+#include "VertexPacking.h"
 
 #include <algorithm>
 #include <unordered_map>
@@ -19,8 +24,40 @@ using namespace std;
 
 #define BUFFER_OFFSET(i) ((char *)NULL + (i))
 
+namespace
+{
+    /// OpenGL type of an attribute component
+    GLenum glType(const VertexLayout::ComponentType type)
+    {
+        switch( type )
+        {
+            case VertexLayout::Half:
+                return GL_HALF_FLOAT_OES;
+            case VertexLayout::UnsignedShort:
+                return GL_UNSIGNED_SHORT;
+            case VertexLayout::Short:
+                return GL_SHORT;
+            case VertexLayout::Float:
+            default:
+                return GL_FLOAT;
+        }
+    }
+
+    /// Point the vertex attribute index to attribute
+    void setAttribute(const GLuint index, const VertexLayout::Attribute& attribute,
+                      const VertexLayout& layout, const size_t offset)
+    {
+        glEnableVertexAttribArray(index);
+        glVertexAttribPointer(index, attribute.components, glType(attribute.type),
+                              attribute.normalized ? GL_TRUE : GL_FALSE, layout.stride,
+                              BUFFER_OFFSET(offset + attribute.offset));
+    }
+}
+
 WavefrontRenderer::WavefrontRenderer(const IObject& object,
-                                     const bool splitInTriangles/*=true*/)
+                                     const bool splitInTriangles/*=true*/,
+                                     const VertexLayout::Format vertexFormat
+                                     /*=VertexLayout::Normalized16*/)
 {
     if( object.empty() )
     {
@@ -28,10 +65,89 @@ WavefrontRenderer::WavefrontRenderer(const IObject& object,
         return;
     }
 
-    m_vertexBuffer = object.vertexBuffer();
+    // the object builds the buffer once for these options, the steps below
+    // only run for buffers that were built with other options
+    VertexBufferOptions options;
+    if( splitInTriangles )
+    {
+        options = bufferOptions(vertexFormat);
+    }
+    else
+    {
+        // quads are kept in the buffer and triangulated below
+        options.splitInTriangles = false;
+    }
+    m_vertexBuffer = object.vertexBuffer(options);
     assert(!m_vertexBuffer.empty());
 
-    generateOpenGLBuffers();
+    // OpenGL ES has no quads, every command is drawn as a triangle list
+    if( m_vertexBuffer.indexSize == 4 )
+    {
+        WavefrontFileReader::triangulateQuads(m_vertexBuffer);
+    }
+
+    // coarser levels are drawn when the object is far away
+    if( m_vertexBuffer.lods.empty() && (m_vertexBuffer.indexSize == 4) )
+    {
+        WavefrontFileReader::generateLods(m_vertexBuffer);
+    }
+
+    // 16 bits indices halve the index buffer and are supported by every
+    // OpenGL ES 2 device, 32 bits indices need OES_element_index_uint
+    WavefrontFileReader::convertToShortIndices(m_vertexBuffer, true);
+
+    // compact vertices use less than half of the memory and bandwidth
+    WavefrontFileReader::packVertices(m_vertexBuffer, vertexFormat);
+
+    // meshlets allow to skip the triangles facing away from the camera
+    if( m_vertexBuffer.meshlets.empty() )
+    {
+        WavefrontFileReader::buildMeshlets(m_vertexBuffer);
+    }
+
+    const auto& vbo = m_vertexBuffer.vbo;
+    const auto& packedVbo = m_vertexBuffer.packedVbo;
+    const bool packed = (m_vertexBuffer.layout.format != VertexLayout::Float32);
+    const void* vertices = packed ? (const void*)packedVbo.data() : (const void*)vbo.data();
+
+    const auto& ibo = m_vertexBuffer.ibo;
+    const auto& ibo16 = m_vertexBuffer.ibo16;
+    const bool shortIndices = (m_vertexBuffer.indexSize == 2);
+    const void* indices = shortIndices ? (const void*)ibo16.data() : (const void*)ibo.data();
+
+    generateOpenGLBuffers(vertices, packed ? packedVbo.size() : vbo.size() * sizeof(Vertex),
+                          indices, m_vertexBuffer.indicesCount() * m_vertexBuffer.indexSize);
+}
+
+WavefrontRenderer::WavefrontRenderer(const WavefrontFileReader::CacheFile& cache)
+{
+    m_vertexBuffer.layout = cache.layout();
+    m_vertexBuffer.indexSize = cache.indexSize();
+    m_vertexBuffer.scale = cache.scale();
+
+    const auto commands = cache.commands();
+    m_vertexBuffer.commands.assign(commands.begin(), commands.end());
+    const auto meshlets = cache.meshlets();
+    m_vertexBuffer.meshlets.assign(meshlets.begin(), meshlets.end());
+    m_vertexBuffer.lods = cache.lods();
+
+    const auto vertices = cache.vertexData();
+    const auto indices = cache.indexData();
+    generateOpenGLBuffers(vertices.begin(), vertices.size(), indices.begin(), indices.size());
+}
+
+VertexBufferOptions WavefrontRenderer::bufferOptions(const VertexLayout::Format vertexFormat
+                                                     /*=VertexLayout::Normalized16*/)
+{
+    // the same steps as the constructor
+    VertexBufferOptions options;
+    options.splitInTriangles = true;
+    options.lodRatios = { 0.5f, 0.25f, 0.1f };
+    options.shortIndices = true;
+    options.splitCommands = true;
+    options.vertexFormat = vertexFormat;
+    options.meshlets = true;
+    return options;
 }
 
 WavefrontRenderer::~WavefrontRenderer()
@@ -50,6 +166,55 @@ WavefrontRenderer::~WavefrontRenderer()
 }
 
 void WavefrontRenderer::draw() const
+{
+    drawCommands(nullptr);
+}
+
+void WavefrontRenderer::draw(const fvec3& cameraPosition) const
+{
+    drawCommands([&cameraPosition](const Meshlet& meshlet) {
+        return !WavefrontFileReader::isBackFacing(meshlet, cameraPosition);
+    });
+}
+
+void WavefrontRenderer::drawLod(const size_t level) const
+{
+    if( (level == 0) || (level > m_vertexBuffer.lods.size()) )
+    {
+        draw();
+        return;
+    }
+
+    // the default frustum contains everything
+    draw(WavefrontFileReader::Frustum(), level);
+}
+
+WavefrontRenderer::CullingStatistics
+WavefrontRenderer::draw(const WavefrontFileReader::Frustum& frustum,
+                        const size_t level/*=0*/) const
+{
+    const auto& commands = levelCommands(level);
+
+    std::vector<uint32_t> visible;
+    CullingStatistics statistics;
+    statistics.culled = WavefrontFileReader::cullCommands(commands, frustum, visible);
+    statistics.visible = visible.size();
+
+    drawSelected(commands, visible);
+    return statistics;
+}
+
+const std::vector<Command>& WavefrontRenderer::levelCommands(const size_t level) const
+{
+    if( (level == 0) || (level > m_vertexBuffer.lods.size()) )
+    {
+        return m_vertexBuffer.commands;
+    }
+    return m_vertexBuffer.lods[level - 1].commands;
+}
+
+void WavefrontRenderer::drawSelected(const std::vector<Command>& commands,
+                                     const std::vector<uint32_t>& selected) const
 {
     if( m_iboId <= 0 )
     {
@@ -57,49 +222,145 @@ void WavefrontRenderer::draw() const
         return;
     }
 
+    glBindBuffer(GL_ARRAY_BUFFER, m_vboId);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_iboId);
 
+    uint32_t baseVertex = 0;
+    for( const auto i : selected )
+    {
+        const Command& command = commands[i];
+        drawRange(command, command.index, command.count, baseVertex);
+    }
+
+    if( baseVertex != 0 )
+    {
+        bindVertexAttributes(0);
+    }
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+size_t WavefrontRenderer::lodLevel(const float distance, const float projectionScale,
+                                   const float maxPixelError/*=1.0f*/) const
+{
+    return WavefrontFileReader::selectLod(m_vertexBuffer, distance, projectionScale,
+                                          maxPixelError);
+}
+
+void WavefrontRenderer::drawCommands(const std::function<bool(const Meshlet&)>& isVisible) const
+{
+    if( m_iboId <= 0 )
+    {
+        assert( false );
+        return;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_vboId);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_iboId);
+
+    const bool useMeshlets = isVisible && !m_vertexBuffer.meshlets.empty();
+    uint32_t baseVertex = 0;
+
     for( auto& command : m_vertexBuffer.commands )
     {
-        GLenum drawType = (command.type == Command::Triangles)
-                ? GL_TRIANGLES : GL_TRIANGLE_FAN;
+        // triangles are drawn by meshlets
+        if( !useMeshlets || (command.type != Command::Triangles) )
+        {
+            drawRange(command, command.index, command.count, baseVertex);
+        }
+    }
+
+    if( useMeshlets )
+    {
+        // consecutive visible meshlets are drawn together
+        const Meshlet* pending = nullptr;
+        uint32_t pendingCount = 0;
+
+        for( auto& meshlet : m_vertexBuffer.meshlets )
+        {
+            if( !isVisible(meshlet) )
+            {
+                continue;
+            }
+
+            if( (pending != nullptr) && (pending->command == meshlet.command) &&
+                (pending->index + pendingCount == meshlet.index) )
+            {
+                pendingCount += meshlet.count;
+                continue;
+            }
+
+            if( pending != nullptr )
+            {
+                drawRange(m_vertexBuffer.commands[pending->command], pending->index,
+                          pendingCount, baseVertex);
+            }
+
+            pending = &meshlet;
+            pendingCount = meshlet.count;
+        }
 
-        glDrawElements(drawType, command.count, GL_UNSIGNED_INT,
-                       (void*)(command.index * sizeof(uint32_t)));
+        if( pending != nullptr )
+        {
+            drawRange(m_vertexBuffer.commands[pending->command], pending->index,
+                      pendingCount, baseVertex);
+        }
+    }
+
+    if( baseVertex != 0 )
+    {
+        bindVertexAttributes(0);
     }
 
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
-void WavefrontRenderer::generateOpenGLBuffers()
+void WavefrontRenderer::drawRange(const Command& command, const uint32_t index,
+                                  const uint32_t count, uint32_t& baseVertex) const
+{
+    const unsigned indexSize = m_vertexBuffer.indexSize;
+    const GLenum indexType = (indexSize == 2) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+
+    // quads were split in triangles by the constructor
+    assert( command.type == Command::Triangles );
+
+    // OpenGL ES 2 can't draw with a base vertex, the attributes are
+    // moved to the first vertex of the command instead
+    if( command.baseVertex != baseVertex )
+    {
+        baseVertex = command.baseVertex;
+        bindVertexAttributes(baseVertex);
+    }
+
+    glDrawElements(GL_TRIANGLES, count, indexType,
+                   BUFFER_OFFSET(size_t(index) * indexSize));
+}
+
+void WavefrontRenderer::bindVertexAttributes(const uint32_t baseVertex) const
 {
-    auto& ibo = m_vertexBuffer.ibo;
-    auto& vbo = m_vertexBuffer.vbo;
-    
-    assert( !ibo.empty() && !vbo.empty() );
+    const auto& layout = m_vertexBuffer.layout;
+    const size_t offset = size_t(baseVertex) * layout.stride;
+
+    setAttribute(0, layout.position, layout, offset);
+    setAttribute(1, layout.normal, layout, offset);
+}
+
+void WavefrontRenderer::generateOpenGLBuffers(const void* vertices, const size_t verticesSize,
+                                              const void* indices, const size_t indicesSize)
+{
+    assert( (verticesSize > 0) && (indicesSize > 0) );
 
     glGenBuffers(1, &m_vboId);
     assert( m_vboId > 0 );
     glBindBuffer(GL_ARRAY_BUFFER, m_vboId);
-
-    glBufferData(GL_ARRAY_BUFFER, vbo.size() * sizeof(vbo.front()),
-                 vbo.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, verticesSize, vertices, GL_STATIC_DRAW);
 
     glGenBuffers(1, &m_iboId);
     assert( m_iboId > 0 );
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_iboId);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indicesSize, indices, GL_STATIC_DRAW);
 
-
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, ibo.size() * sizeof(ibo.front()),
-                 ibo.data(), GL_STATIC_DRAW);
-
-    glEnableVertexAttribArray(0); // position
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE,
-                          sizeof(Vertex), BUFFER_OFFSET(0));
-
-    glEnableVertexAttribArray(1); // normal
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE,
-                          sizeof(Vertex), BUFFER_OFFSET(12));
+    bindVertexAttributes(0);
 
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
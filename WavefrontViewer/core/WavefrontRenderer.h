@@ -11,11 +11,14 @@
 
 #include <cstdio>
 #include <vector>
+#include <functional>
 
 #include <OpenGLES/ES2/glext.h>
 
 #include "types.h"
 #include "IObject.h"
+#include "Frustum.h"
+#include "BinaryCache.h"
 
 /**
  * Renders an wavefront file
@@ -33,9 +36,28 @@ public:
      * @param splitInTriangles - specify if it should transform everithing in
      *                  triangles if a face has more then 3 indices.
      *                  By default is true
+     * @param vertexFormat - format of the vertices uploaded to OpenGL. The
+     *                  shader decodes them using @see vertexLayout
      */
     WavefrontRenderer(const IObject& reader,
-                      const bool splitInTriangles = true);
+                      const bool splitInTriangles = true,
+                      const VertexLayout::Format vertexFormat = VertexLayout::Normalized16);
+
+    /**
+     * Upload a cached vertex buffer. The vertices and indices go from the
+     * mapped cache to OpenGL without being copied or converted.
+     * @param cache - cache of a buffer built with @see bufferOptions
+     */
+    explicit WavefrontRenderer(const WavefrontFileReader::CacheFile& cache);
+
+    /**
+     * Options that build a vertex buffer ready to be drawn, the constructors
+     * don't process it again. Use them for the buffers given to the
+     * renderer, for example with @see WavefrontFileReader::loadCachedFile
+     * @param vertexFormat - format of the vertices uploaded to OpenGL
+     */
+    static VertexBufferOptions bufferOptions(const VertexLayout::Format vertexFormat =
+                                             VertexLayout::Normalized16);
 
     /**
      * Class destructorgenerateBuffers
@@ -47,17 +69,101 @@ public:
      */
     void draw() const;
 
+    /**
+     * Render the object without the meshlets that face away from the camera.
+     * Use it only with back face culling enabled, or for closed meshes.
+     * @param cameraPosition - camera position in model coordinates
+     */
+    void draw(const fvec3& cameraPosition) const;
+
+    /**
+     * Number of commands drawn and culled by @see draw with a frustum
+     */
+    struct CullingStatistics
+    {
+        size_t visible = 0; /// commands drawn
+        size_t culled = 0; /// commands outside the frustum
+    };
+
+    /**
+     * Render the commands whose bounds may be inside the view frustum
+     * @param frustum - view frustum in model coordinates
+     * @param level - level of detail, 0 for the full detail
+     * @return Returns the number of drawn and culled commands
+     */
+    CullingStatistics draw(const WavefrontFileReader::Frustum& frustum,
+                           const size_t level = 0) const;
+
+    /**
+     * Render a level of detail
+     * @param level - 0 for the full detail, @see lodLevel
+     */
+    void drawLod(const size_t level) const;
+
+    /**
+     * Coarsest level of detail that looks like the full detail on screen
+     * @param distance - distance between the camera and the object center
+     * @param projectionScale - viewport height / (2 * tan(vertical fov / 2))
+     * @param maxPixelError - largest accepted error, in pixels
+     */
+    size_t lodLevel(const float distance, const float projectionScale,
+                    const float maxPixelError = 1.0f) const;
+
+    /// Number of levels of detail, including the full detail
+    size_t lodCount() const { return m_vertexBuffer.lods.size() + 1; }
+
 public:
     float maxCoordinateValue() const { return m_vertexBuffer.scale; }
 
+    /// Format of the uploaded vertices
+    const VertexLayout& vertexLayout() const { return m_vertexBuffer.layout; }
+
 private:
     /**
      * Create opengl representations for buffers created with @see
      * generateBuffers
-     * @param vbo - VBO buffer
-     * @param ibo - index buffer object
+     * @param vertices - vertices in the layout format
+     * @param verticesSize - size of the vertices in bytes
+     * @param indices - indices of m_vertexBuffer.indexSize bytes
+     * @param indicesSize - size of the indices in bytes
+     */
+    void generateOpenGLBuffers(const void* vertices, const size_t verticesSize,
+                               const void* indices, const size_t indicesSize);
+
+    /**
+     * Set the vertex attributes of the bound vertex buffer object
+     * @param baseVertex - vertex used by index 0
+     */
+    void bindVertexAttributes(const uint32_t baseVertex) const;
+
+    /**
+     * Draw the commands, or the visible meshlets when there are meshlets
+     * @param isVisible - checks if a meshlet is visible. When empty all the
+     *              commands are drawn
+     */
+    void drawCommands(const std::function<bool(const Meshlet&)>& isVisible) const;
+
+    /// Commands of a level of detail, 0 for the full detail
+    const std::vector<Command>& levelCommands(const size_t level) const;
+
+    /**
+     * Draw whole commands
+     * @param commands - commands of a level of detail
+     * @param selected - numbers of the commands to draw
+     */
+    void drawSelected(const std::vector<Command>& commands,
+                      const std::vector<uint32_t>& selected) const;
+
+    /**
+     * Draw a range of indices from a command
+     * @param command - command that contains the range
+     * @param index - first index
+     * @param count - number of indices
+     * @param baseVertex - base vertex of the bound attributes, updated when
+     *              the attributes are moved to the command base vertex
      */
-    void generateOpenGLBuffers();
+    void drawRange(const Command& command, const uint32_t index,
+                   const uint32_t count, uint32_t& baseVertex) const;
 
 private:
     GLuint m_vboId = 0; /// opengl vertex buffer object id
@@ -10,6 +10,8 @@
 #define types_h
 
 #include <cinttypes>
+#include <cstddef>
+#include <cmath>
 
 /**
  * Represents a 3D floating point
@@ -21,17 +23,110 @@ struct Vec3
     T y = T(0); /// y-coordinate
     T z = T(0); /// z-coordinate
 
+    Vec3() {}
+    Vec3(T a, T b, T c) : x(a), y(b), z(c) {}
+
     bool operator== (const Vec3& other) const
     {
         return ((this->x == other.x) &&
                 (this->y == other.y) &&
                 (this->z == other.z));
     }
+
+    Vec3 operator+ (const Vec3& other) const { return Vec3(x + other.x, y + other.y, z + other.z); }
+    Vec3 operator- (const Vec3& other) const { return Vec3(x - other.x, y - other.y, z - other.z); }
+    Vec3 operator* (T s) const { return Vec3(x * s, y * s, z * s); }
 };
 
+template<class T>
+T dot(const Vec3<T>& a, const Vec3<T>& b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+template<class T>
+Vec3<T> cross(const Vec3<T>& a, const Vec3<T>& b)
+{
+    return Vec3<T>(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+}
+
+template<class T>
+T length(const Vec3<T>& a)
+{
+    return std::sqrt(dot(a, a));
+}
+
+/// Vector with length 1 in the same direction. Zero vectors stay zero
+template<class T>
+Vec3<T> normalize(const Vec3<T>& a)
+{
+    const T l = length(a);
+    return (l > T(0)) ? a * (T(1) / l) : a;
+}
+
 typedef Vec3<float> fvec3;
 typedef Vec3<int> ivec3;
 
+/**
+ * Axis aligned bounding box and bounding sphere of a set of points. The box
+ * of an empty set has low above high.
+ */
+struct Bounds
+{
+    fvec3 low = fvec3(INFINITY, INFINITY, INFINITY); /// smallest coordinates
+    fvec3 high = fvec3(-INFINITY, -INFINITY, -INFINITY); /// largest coordinates
+    fvec3 center; /// bounding sphere center, the box center
+    float radius = 0.0f; /// bounding sphere radius
+
+    bool empty() const { return low.x > high.x; }
+};
+
+/**
+ * Range of consecutive elements from an array. Doesn't own the elements.
+ */
+template<class T>
+class ArrayView
+{
+public:
+    ArrayView() {}
+    ArrayView(const T* begin, const T* end) : m_begin(begin), m_end(end) {}
+
+    const T* begin() const { return m_begin; }
+    const T* end() const { return m_end; }
+
+    size_t size() const { return size_t(m_end - m_begin); }
+    bool empty() const { return m_begin == m_end; }
+
+    const T& operator[] (size_t i) const { return m_begin[i]; }
+    const T& front() const { return *m_begin; }
+    const T& back() const { return *(m_end - 1); }
+
+    /**
+     * Compare the elements from the two ranges
+     * @return true when the ranges have the same size and equal elements
+     */
+    bool operator== (const ArrayView& other) const
+    {
+        if( size() != other.size() )
+        {
+            return false;
+        }
+
+        for( size_t i = 0; i < size(); ++i )
+        {
+            if( !(m_begin[i] == other.m_begin[i]) )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    const T* m_begin = nullptr; /// first element
+    const T* m_end = nullptr; /// one past the last element
+};
+
 /**
  * Store face indices read from file
  */
@@ -88,13 +183,36 @@ struct Command
     Type type = Triangles; /// render type
     uint32_t index = 0; /// starting index from current VBO
     uint32_t count = 0; /// number of elements that need to be drawn
+    uint32_t baseVertex = 0; /// added to every index of the command
+    Bounds bounds; /// bounds of the vertices used by the command
 
     bool operator== (const Command& other) const
     {
         return ((this->type == other.type) &&
                 (this->index == other.index) &&
-                (this->count == other.count));
+                (this->count == other.count) &&
+                (this->baseVertex == other.baseVertex));
     }
 };
 
+/**
+ * Small group of triangles from a command, drawn and culled together
+ */
+struct Meshlet
+{
+    uint32_t command = 0; /// command that contains the meshlet
+    uint32_t index = 0; /// first index, inside the command range
+    uint32_t count = 0; /// number of indices
+    uint32_t verticesCount = 0; /// number of different vertices used
+
+    fvec3 center; /// bounding sphere center
+    float radius = 0.0f; /// bounding sphere radius
+
+    /// Normal cone: all the triangle normals are inside the cone around
+    /// coneAxis. coneCutoff is the sine of the cone angle, or 1 when the
+    /// triangles face too many directions to be culled
+    fvec3 coneAxis;
+    float coneCutoff = 1.0f;
+};
+
 #endif /* types_h */